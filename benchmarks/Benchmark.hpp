@@ -0,0 +1,52 @@
+#ifndef LANGD_BENCHMARK_HPP
+#define LANGD_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace langd {
+    namespace benchmarks {
+        template<typename Function>
+        double secondsFor(Function function) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count();
+        }
+
+        template<typename Function>
+        double bestOf(int runs, Function function) {
+            double best = secondsFor(function);
+            for (int i = 1; i < runs; i++) {
+                double seconds = secondsFor(function);
+                if (seconds < best) {
+                    best = seconds;
+                }
+            }
+            return best;
+        }
+
+        inline long argument(int argc, char **argv, int index, long fallback) {
+            return argc > index ? std::atol(argv[index]) : fallback;
+        }
+
+        template<typename Function>
+        void scaling(const char *title, long from, long to, Function function) {
+            std::printf("%s\n", title);
+            std::printf("%10s %12s %12s %10s\n", "n", "seconds", "ns/item", "growth");
+
+            double previous = 0;
+            for (long n = from; n <= to; n *= 2) {
+                double seconds = bestOf(3, [&]() {
+                    function(n);
+                });
+                std::printf("%10ld %12.4f %12.1f %10.2f\n", n, seconds, seconds * 1e9 / n, previous > 0 ? seconds / previous : 0);
+                previous = seconds;
+            }
+            std::printf("\n");
+        }
+    }
+}
+
+#endif //LANGD_BENCHMARK_HPP
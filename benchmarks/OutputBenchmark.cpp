@@ -0,0 +1,50 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <codegen/Output.hpp>
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace langd::benchmarks;
+using namespace langd::codegen;
+
+vector<string> generateLines(long count) {
+    vector<string> lines;
+    lines.reserve(count);
+    lines.push_back("        int v0 = 1;");
+    for (long i = 1; i < count; i++) {
+        lines.push_back("        int v" + to_string(i) + " = v" + to_string(i - 1) + " + " + to_string(i % 1000) + ";");
+    }
+    return lines;
+}
+
+int main(int argc, char **argv) {
+    long count = argument(argc, argv, 1, 2000000);
+    string path = argc > 2 ? argv[2] : "bench_output.txt";
+    auto lines = generateLines(count);
+
+    size_t bytes = 0;
+    for (auto &line: lines) {
+        bytes += line.size() + 1;
+    }
+
+    auto streamSeconds = bestOf(3, [&]() {
+        ofstream out(path);
+        for (auto &line: lines) {
+            out << line << endl;
+        }
+    });
+
+    auto outputSeconds = bestOf(3, [&]() {
+        Output out(path);
+        for (auto &line: lines) {
+            out << line << '\n';
+        }
+    });
+
+    printf("%ld lines, %.1f MB to %s\n", count, bytes / 1e6, path.c_str());
+    printf("%-24s %14.0f lines/s %10.1f MB/s\n", "ofstream + endl", count / streamSeconds, bytes / 1e6 / streamSeconds);
+    printf("%-24s %14.0f lines/s %10.1f MB/s\n", "codegen::Output", count / outputSeconds, bytes / 1e6 / outputSeconds);
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <string>
+#include <vector>
+#include <codegen/NameAllocator.hpp>
+#include <codegen/Output.hpp>
+#include <java/JavaPrinter.hpp>
+#include <semantic/NodePool.hpp>
+#include "Benchmark.hpp"
+
+using namespace std;
+using namespace langd;
+using namespace langd::benchmarks;
+
+void allocateNames(long count) {
+    codegen::NameAllocator names;
+    for (long i = 0; i < count; i += 16) {
+        names.reserve("t_" + to_string(i));
+    }
+    for (long i = 0; i < count; i++) {
+        names.allocate("t");
+    }
+}
+
+void scanNames(long count) {
+    vector<string> names;
+    for (long n = 0; n < count; n++) {
+        for (int i = 0; true; i++) {
+            auto name = "t_" + to_string(i);
+            bool isNew = true;
+            for (auto &taken: names) {
+                if (taken == name) {
+                    isNew = false;
+                    break;
+                }
+            }
+            if (isNew) {
+                names.push_back(name);
+                break;
+            }
+        }
+    }
+}
+
+void printLocals(long count, string path) {
+    semantic::NodePool nodes;
+
+    vector<semantic::Expression *> statements;
+    statements.push_back(new semantic::Assignment("v0", new semantic::IntConstant(1)));
+    for (long i = 1; i < count; i++) {
+        auto previous = new semantic::VariableReference("v" + to_string(i - 1), &semantic::INTEGER);
+        auto sum = new semantic::PlusOperation(previous, new semantic::IntConstant(i % 1000));
+        statements.push_back(new semantic::Assignment("v" + to_string(i), sum));
+    }
+    statements.push_back(new semantic::VariableReference("v" + to_string(count - 1), &semantic::INTEGER));
+
+    codegen::Output out(path);
+    java::JavaPrinter printer(out);
+    printer.print(new semantic::Block(statements));
+}
+
+int main(int argc, char **argv) {
+    long maxNames = argument(argc, argv, 1, 1 << 20);
+    long maxLocals = argument(argc, argv, 2, 1 << 17);
+    string path = argc > 3 ? argv[3] : "bench_output.txt";
+
+    scaling("Linear scan over taken names, one prefix", 1 << 6, 1 << 9, scanNames);
+    scaling("NameAllocator::allocate, one prefix", 1 << 10, maxNames, allocateNames);
+    scaling("JavaPrinter, one local per statement", 1 << 10, maxLocals, [&](long count) {
+        printLocals(count, path);
+    });
+    return 0;
+}
@@ -0,0 +1,12 @@
+# Writes OUTPUT with a hash of the compiler sources and flags. Class caches
+# written by a different build of langd are discarded on load.
+set(contents "${COMPILER}")
+foreach(source ${SOURCES})
+    file(SHA1 ${source} hash)
+    set(contents "${contents}\n${source} ${hash}")
+endforeach()
+string(SHA1 id "${contents}")
+
+file(WRITE ${OUTPUT}.tmp "#ifndef LANGD_BUILDID_HPP\n#define LANGD_BUILDID_HPP\n\n#define LANGD_BUILD_ID \"${id}\"\n\n#endif //LANGD_BUILDID_HPP\n")
+configure_file(${OUTPUT}.tmp ${OUTPUT} COPYONLY)
+file(REMOVE ${OUTPUT}.tmp)
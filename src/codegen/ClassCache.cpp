@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "BuildId.hpp"
+#include "ClassCache.hpp"
+#include "Output.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace codegen {
+        string ClassCache::version() {
+            return "langd-cache 2 " LANGD_BUILD_ID;
+        }
+
+        void ClassCache::load() {
+            ifstream in(path);
+            string line;
+            if (!getline(in, line)) {
+                return;
+            }
+            bool current = line == version();
+
+            while (getline(in, line)) {
+                istringstream fields(line);
+                string kind;
+                string name;
+                fields >> kind >> name;
+
+                if (kind == "class") {
+                    previousClasses.insert(name);
+                }
+                if (!current) {
+                    continue;
+                }
+
+                if (kind == "class") {
+                    reset(name);
+                } else if (kind == "dependency") {
+                    string dependency;
+                    fields >> dependency;
+                    addDependency(name, dependency);
+                } else if (kind == "constant") {
+                    string constant;
+                    string field;
+                    fields >> constant;
+                    getline(fields >> ws, field);
+                    addConstant(name, constant, field);
+                }
+            }
+        }
+
+        void ClassCache::save(const set<string> &live) {
+            Output out(path);
+            out << version() << '\n';
+            for (auto name: live) {
+                out << "class " << name << '\n';
+                auto entry = entries.find(name);
+                if (entry == entries.end()) {
+                    continue;
+                }
+
+                for (auto dependency: entry->second.dependencies) {
+                    out << "dependency " << name << " " << dependency << '\n';
+                }
+                for (auto constant: entry->second.constants) {
+                    out << "constant " << name << " " << constant.first << " " << constant.second << '\n';
+                }
+            }
+        }
+
+        void ClassCache::addDependency(string name, string dependency) {
+            auto &dependencies = entries[name].dependencies;
+            if (find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end()) {
+                dependencies.push_back(dependency);
+            }
+        }
+
+        void ClassCache::addConstant(string name, string constant, string field) {
+            auto &constants = entries[name].constants;
+            for (auto existing: constants) {
+                if (existing.first == constant) {
+                    return;
+                }
+            }
+            constants.emplace_back(constant, field);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef LANGD_CLASSCACHE_HPP
+#define LANGD_CLASSCACHE_HPP
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace langd {
+    namespace codegen {
+        class ClassCache {
+        public:
+            explicit ClassCache(std::string path) : path(path) {}
+
+            void load();
+
+            void save(const std::set<std::string> &live);
+
+            bool contains(std::string name) {
+                return entries.count(name) != 0;
+            }
+
+            void reset(std::string name) {
+                entries[name] = Entry();
+            }
+
+            void addDependency(std::string name, std::string dependency);
+
+            void addConstant(std::string name, std::string constant, std::string field);
+
+            std::vector<std::string> getDependencies(std::string name) {
+                return entries[name].dependencies;
+            }
+
+            std::vector<std::pair<std::string, std::string>> getConstants(std::string name) {
+                return entries[name].constants;
+            }
+
+            std::set<std::string> getPreviousClasses() {
+                return previousClasses;
+            }
+
+        private:
+            static std::string version();
+
+            struct Entry {
+                std::vector<std::string> dependencies;
+                std::vector<std::pair<std::string, std::string>> constants;
+            };
+
+            std::string path;
+            std::map<std::string, Entry> entries;
+            std::set<std::string> previousClasses;
+        };
+    }
+}
+
+#endif //LANGD_CLASSCACHE_HPP
@@ -0,0 +1,27 @@
+#include "Hash.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace codegen {
+        uint64_t stableHash(const string &text) {
+            uint64_t hash = 14695981039346656037ULL;
+            for (unsigned char character: text) {
+                hash ^= character;
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        string toHex(uint64_t value) {
+            static const char digits[] = "0123456789abcdef";
+
+            string hex(16, '0');
+            for (int i = 15; i >= 0; i--) {
+                hex[i] = digits[value & 0xf];
+                value >>= 4;
+            }
+            return hex;
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef LANGD_HASH_HPP
+#define LANGD_HASH_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace langd {
+    namespace codegen {
+        uint64_t stableHash(const std::string &text);
+
+        std::string toHex(uint64_t value);
+    }
+}
+
+#endif //LANGD_HASH_HPP
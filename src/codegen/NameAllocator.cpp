@@ -0,0 +1,17 @@
+#include "NameAllocator.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace codegen {
+        string NameAllocator::allocate(string prefix) {
+            int &counter = counters[prefix];
+            while (true) {
+                auto name = prefix + "_" + to_string(counter++);
+                if (names.insert(name).second) {
+                    return name;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef LANGD_NAMEALLOCATOR_HPP
+#define LANGD_NAMEALLOCATOR_HPP
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace langd {
+    namespace codegen {
+        class NameAllocator {
+        public:
+            std::string allocate(std::string prefix);
+
+            void reserve(std::string name) {
+                names.insert(name);
+            }
+
+            bool isTaken(std::string name) {
+                return names.count(name) != 0;
+            }
+
+        private:
+            std::unordered_map<std::string, int> counters;
+            std::unordered_set<std::string> names;
+        };
+    }
+}
+
+#endif //LANGD_NAMEALLOCATOR_HPP
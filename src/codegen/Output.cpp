@@ -0,0 +1,92 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Output.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace codegen {
+        Output::Output(int fd) : fd(fd), ownsFd(false) {
+            buffer.reserve(CAPACITY);
+        }
+
+        Output::Output(string path) : fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), ownsFd(true) {
+            if (fd < 0) {
+                throw runtime_error("Could not open " + path + ": " + strerror(errno));
+            }
+            buffer.reserve(CAPACITY);
+        }
+
+        void Output::redirect(string path) {
+            flush();
+            if (ownsFd) {
+                ::close(fd);
+            }
+
+            fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            ownsFd = true;
+            if (fd < 0) {
+                ownsFd = false;
+                throw runtime_error("Could not open " + path + ": " + strerror(errno));
+            }
+        }
+
+        Output::~Output() {
+            try {
+                flush();
+            } catch (runtime_error &) {
+            }
+
+            if (ownsFd) {
+                ::close(fd);
+            }
+        }
+
+        Output &Output::operator<<(const string &text) {
+            buffer += text;
+            flushIfFull();
+            return *this;
+        }
+
+        Output &Output::operator<<(const char *text) {
+            buffer += text;
+            flushIfFull();
+            return *this;
+        }
+
+        Output &Output::operator<<(char character) {
+            buffer += character;
+            flushIfFull();
+            return *this;
+        }
+
+        Output &Output::operator<<(int value) {
+            buffer += to_string(value);
+            flushIfFull();
+            return *this;
+        }
+
+        void Output::flush() {
+            const char *data = buffer.data();
+            size_t remaining = buffer.size();
+
+            while (remaining > 0) {
+                auto count = ::write(fd, data, remaining);
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw runtime_error(string("Could not write output: ") + strerror(errno));
+                }
+                data += count;
+                remaining -= count;
+            }
+
+            flushed += buffer.size();
+            buffer.clear();
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef LANGD_OUTPUT_HPP
+#define LANGD_OUTPUT_HPP
+
+#include <string>
+
+namespace langd {
+    namespace codegen {
+        class Output {
+        public:
+            explicit Output(int fd);
+
+            explicit Output(std::string path);
+
+            ~Output();
+
+            Output &operator<<(const std::string &text);
+
+            Output &operator<<(const char *text);
+
+            Output &operator<<(char character);
+
+            Output &operator<<(int value);
+
+            void flush();
+
+            void redirect(std::string path);
+
+            size_t getWritten() {
+                return flushed + buffer.size();
+            }
+
+        private:
+            static const size_t CAPACITY = 1 << 20;
+
+            int fd;
+            bool ownsFd;
+            std::string buffer;
+            size_t flushed = 0;
+
+            void flushIfFull() {
+                if (buffer.size() >= CAPACITY) {
+                    flush();
+                }
+            }
+        };
+    }
+}
+
+#endif //LANGD_OUTPUT_HPP
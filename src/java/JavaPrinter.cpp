@@ -2,171 +2,778 @@
 // Created by xtrit on 1/08/17.
 //
 
-#include <iostream>
+#include <set>
 #include <sstream>
+#include <unistd.h>
+#include <codegen/Hash.hpp>
+#include <semantic/ConstantFolder.hpp>
+#include <semantic/ExpressionTransformer.hpp>
+#include <semantic/FreeVariables.hpp>
 #include "JavaPrinter.hpp"
 
 using namespace std;
 
 namespace langd {
     namespace java {
-        JavaPrinter::JavaPrinter() : typeMapper(new TypeMapper) {
+        string join(vector<string> values, string separator) {
+            string result;
+            for (auto value: values) {
+                result += (result.empty() ? "" : separator) + value;
+            }
+            return result;
+        }
+
+        bool isHoistable(semantic::Expression *expression) {
+            if (auto concatenation = dynamic_cast<semantic::Concatenation *>(expression)) {
+                return isHoistable(concatenation->getLhs()) && isHoistable(concatenation->getRhs());
+            }
 
+            if (auto tuple = dynamic_cast<semantic::Tuple *>(expression)) {
+                for (auto element: tuple->getElements()) {
+                    if (!isHoistable(element.getExpression())) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            return semantic::ConstantFolder::isConstant(expression);
+        }
+
+        class FunctionKey : public semantic::ExpressionVisitor {
+        public:
+            FunctionKey(TypeMapper *typeMapper, map<string, string> names) : typeMapper(typeMapper), scopes({names}) {}
+
+            string key;
+            string declared;
+
+            void visit(semantic::Block *block) override {
+                scopes.emplace_back();
+                key += "{";
+                for (auto statement: block->getExpressions()) {
+                    statement->accept(this);
+                    key += ";";
+                }
+                key += "}";
+                scopes.pop_back();
+            }
+
+            void visit(semantic::Assignment *assignment) override {
+                declared += assignment->getName() + ",";
+                auto local = "l" + to_string(nextName++);
+                key += "let " + local + "=";
+                assignment->getExpression()->accept(this);
+                scopes.back()[assignment->getName()] = local;
+            }
+
+            void visit(semantic::VariableReference *variableReference) override {
+                key += resolve(variableReference->getName());
+            }
+
+            void visit(semantic::PlusOperation *expression) override {
+                binary("+", expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(semantic::MinusOperation *expression) override {
+                binary("-", expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(semantic::TimesOperation *expression) override {
+                binary("*", expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(semantic::ShiftLeftOperation *expression) override {
+                binary("<<", expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(semantic::Concatenation *expression) override {
+                binary("++", expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(semantic::Negation *expression) override {
+                key += "(-";
+                expression->getExpression()->accept(this);
+                key += ")";
+            }
+
+            void visit(semantic::StringConstant *expression) override {
+                key += expression->getValue();
+            }
+
+            void visit(semantic::IntConstant *expression) override {
+                key += to_string(expression->getValue());
+            }
+
+            void visit(semantic::Tuple *expression) override {
+                key += "new " + typeMapper->map(expression->getType()) + "(";
+                for (auto element: expression->getElements()) {
+                    element.getExpression()->accept(this);
+                    key += ",";
+                }
+                key += ")";
+            }
+
+            void visit(semantic::MemberSelection *expression) override {
+                auto tupleType = dynamic_cast<semantic::TupleType *>(expression->getExpression()->getType());
+                key += "(";
+                expression->getExpression()->accept(this);
+                key += ").e" + to_string(tupleType->indexOf(expression->getElement().getName()));
+            }
+
+            void visit(semantic::FunctionCall *expression) override {
+                key += resolve(expression->getFunction()) + "(";
+                expression->getInput()->accept(this);
+                key += ")";
+            }
+
+            void visit(semantic::FunctionDefinition *expression) override {
+                map<string, string> parameters;
+                for (auto member: expression->getType()->getInputType()->getMembers()) {
+                    parameters[member.getName()] = "l" + to_string(nextName++);
+                    declared += member.getName() + ",";
+                }
+
+                key += "fn " + typeMapper->map(expression->getType());
+                scopes.push_back(parameters);
+                expression->getBody()->accept(this);
+                scopes.pop_back();
+            }
+
+        private:
+            TypeMapper *typeMapper;
+            vector<map<string, string>> scopes;
+            int nextName = 0;
+
+            string resolve(string name) {
+                for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++) {
+                    auto resolved = scope->find(name);
+                    if (resolved != scope->end()) {
+                        return resolved->second;
+                    }
+                }
+                return "?" + name;
+            }
+
+            void binary(string operation, semantic::Expression *lhs, semantic::Expression *rhs) {
+                key += "(";
+                lhs->accept(this);
+                key += operation;
+                rhs->accept(this);
+                key += ")";
+            }
+        };
+
+        class ValueReferences : public semantic::ExpressionTransformer {
+        public:
+            set<string> names;
+
+            void visit(semantic::VariableReference *variableReference) override {
+                names.insert(variableReference->getName());
+                ExpressionTransformer::visit(variableReference);
+            }
+        };
+
+        JavaPrinter::JavaPrinter(codegen::Output &out) : out(out), typeMapper(new TypeMapper) {
+
+        }
+
+        JavaPrinter::JavaPrinter(codegen::Output &out, string directory)
+                : out(out), typeMapper(new TypeMapper), directory(directory) {
+
+        }
+
+        JavaPrinter::~JavaPrinter() {
+            delete ownedCache;
+            delete typeMapper;
         }
 
         void JavaPrinter::print(semantic::Block *block) {
-            cout << "class LangD {" << endl;
-            cout << "    public static void main(String[] args) {" << endl;
+            if (!directory.empty() && cache == nullptr) {
+                ownedCache = new codegen::ClassCache(directory + "/.langd-cache");
+                cache = ownedCache;
+                cache->load();
+            }
+
+            beginClassBody("LangD");
+            out << "class LangD {" << '\n';
+            out << "    public static void main(String[] args) {" << '\n';
+            beginMethod("main", "void", true);
 
             block->accept(this);
 
-            cout << "        System.out.println(String.valueOf(" << lastValue << "));" << endl;
-            cout << "    }" << endl;
+            out << "        System.out.println(String.valueOf(" << lastValue << "));" << '\n';
+            out << "    }" << '\n';
+            if (!directory.empty()) {
+                out << "}" << '\n';
+            }
 
             prefix = "            ";
             printFunctions();
-
+            printConstants();
+            printEnvironments();
+            recordTypes();
             printTupleTypes();
             printFunctionTypes();
 
-            cout << "}" << endl;
+            if (directory.empty()) {
+                out << "}" << '\n';
+            }
+
+            if (cache != nullptr) {
+                recordTypeStructure();
+                removeStaleClasses();
+                cache->save(live);
+            }
+        }
+
+        void JavaPrinter::beginClassBody(string name) {
+            recordTypes();
+            className = name;
+            environmentCount = 0;
+            names = codegen::NameAllocator();
+            live.insert(name);
+        }
+
+        void JavaPrinter::record(string dependency) {
+            if (cache != nullptr && className != "LangD") {
+                cache->addDependency(className, dependency);
+            }
+        }
+
+        void JavaPrinter::recordTypes() {
+            for (auto type: typeMapper->takeUsed()) {
+                record(type);
+            }
+        }
+
+        void JavaPrinter::recordTypeStructure() {
+            auto recordMember = [this](string name, semantic::Type *type) {
+                if (dynamic_cast<semantic::TupleType *>(type) || dynamic_cast<semantic::FunctionType *>(type)) {
+                    cache->addDependency(name, typeMapper->map(type));
+                }
+            };
+
+            for (auto tuple: typeMapper->getTupleTypes()) {
+                live.insert(tuple.first);
+                for (auto member: tuple.second->getMembers()) {
+                    recordMember(tuple.first, member.getType());
+                }
+            }
+
+            for (auto function: typeMapper->getFunctionTypes()) {
+                live.insert(function.first);
+                recordMember(function.first, function.second->getInputType());
+                recordMember(function.first, function.second->getOutputType());
+            }
+        }
+
+        bool JavaPrinter::reuseCachedClass(string name) {
+            if (cache == nullptr) {
+                return false;
+            }
+
+            if (!cache->contains(name) || access((directory + "/" + name + ".java").c_str(), F_OK) != 0) {
+                cacheMisses++;
+                cache->reset(name);
+                return false;
+            }
+
+            cacheHits++;
+            markLive(name);
+            return true;
+        }
+
+        void JavaPrinter::markLive(string name) {
+            if (!live.insert(name).second) {
+                return;
+            }
+
+            for (auto constant: cache->getConstants(name)) {
+                if (constantNames.insert(constant.first).second) {
+                    constantFields.push_back(constant.second);
+                }
+            }
+
+            for (auto dependency: cache->getDependencies(name)) {
+                markLive(dependency);
+            }
+        }
+
+        void JavaPrinter::removeStaleClasses() {
+            for (auto name: cache->getPreviousClasses()) {
+                if (live.count(name) == 0) {
+                    unlink((directory + "/" + name + ".java").c_str());
+                }
+            }
+        }
+
+        void JavaPrinter::beginClass(string name) {
+            if (!directory.empty()) {
+                out.redirect(directory + "/" + name + ".java");
+            }
+        }
+
+        void JavaPrinter::endClass() {
+            out << (directory.empty() ? "    }" : "}") << '\n';
+        }
+
+        string JavaPrinter::nestedModifiers() {
+            return directory.empty() ? "    private static " : "";
+        }
+
+        void JavaPrinter::printConstants() {
+            if (constantFields.empty()) {
+                return;
+            }
+
+            if (!directory.empty()) {
+                beginClass("Constants");
+                out << "final class Constants {" << '\n';
+            }
+
+            for (auto field: constantFields) {
+                out << (directory.empty() ? "    private " : "    ") << field << '\n';
+            }
+
+            if (!directory.empty()) {
+                out << "}" << '\n';
+            }
         }
 
         void JavaPrinter::visit(langd::semantic::Block *block) {
-            for (auto statement: block->getExpressions()) {
-                statement->accept(this);
+            auto statements = block->getExpressions();
+            semantic::FreeVariableIndex freeVariables(statements);
+            for (int i = 0; i < statements.size(); i++) {
+                if (i > 0 && out.getWritten() - methodStart > MAX_METHOD_SIZE) {
+                    vector<string> localNames;
+                    for (auto local: locals) {
+                        localNames.push_back(local.first);
+                    }
+                    splitMethod(freeVariables.of(i, localNames));
+                }
+                statements[i]->accept(this);
             }
         }
 
         void JavaPrinter::visit(langd::semantic::Assignment *assignment) {
             assignment->getExpression()->accept(this);
 
-            cout << prefix << mapType(assignment->getType()) << " " << assignment->getName() << " = ";
-            cout << lastValue << ";" << endl;
+            auto javaType = mapType(assignment->getType());
+            auto definition = dynamic_cast<semantic::FunctionDefinition *>(assignment->getExpression());
+            auto reference = dynamic_cast<semantic::VariableReference *>(assignment->getExpression());
+            if (reference != nullptr && knownFunctions.count(reference->getName()) != 0) {
+                definition = knownFunctions[reference->getName()];
+            }
+
+            if (definition != nullptr) {
+                knownFunctions[assignment->getName()] = definition;
+                javaType = functionClasses[definition];
+            } else {
+                knownFunctions.erase(assignment->getName());
+            }
+
+            out << prefix << javaType << " " << assignment->getName() << " = ";
+            out << lastValue << ";" << '\n';
+            locals[assignment->getName()] = javaType;
         }
 
         void JavaPrinter::visit(langd::semantic::VariableReference *variableReference) {
-            print(variableReference->getType(), "id", variableReference->getName());
+            lastValue = variableReference->getName();
+            lastDepth = 0;
         }
 
         void JavaPrinter::visit(langd::semantic::PlusOperation *expression) {
             expression->getLhs()->accept(this);
             string lhs = lastValue;
+            int depth = lastDepth;
             expression->getRhs()->accept(this);
             string rhs = lastValue;
+            depth = max(depth, lastDepth);
 
-            print(expression->getType(), "plus", lhs, " + ", rhs);
+            print(expression->getType(), "plus", depth, lhs, " + ", rhs);
         }
 
         void JavaPrinter::visit(langd::semantic::MinusOperation *expression) {
             expression->getLhs()->accept(this);
             string lhs = lastValue;
+            int depth = lastDepth;
             expression->getRhs()->accept(this);
             string rhs = lastValue;
+            depth = max(depth, lastDepth);
 
-            print(expression->getType(), "minus", lhs, " - ", rhs);
+            print(expression->getType(), "minus", depth, lhs, " - ", rhs);
         }
 
         void JavaPrinter::visit(langd::semantic::TimesOperation *expression) {
             expression->getLhs()->accept(this);
             string lhs = lastValue;
+            int depth = lastDepth;
             expression->getRhs()->accept(this);
             string rhs = lastValue;
+            depth = max(depth, lastDepth);
 
-            print(expression->getType(), "times", lhs, " * ", rhs);
+            print(expression->getType(), "times", depth, lhs, " * ", rhs);
         }
 
-        void JavaPrinter::visit(langd::semantic::Concatenation *expression) {
+        void JavaPrinter::visit(langd::semantic::ShiftLeftOperation *expression) {
             expression->getLhs()->accept(this);
             string lhs = lastValue;
+            int depth = lastDepth;
             expression->getRhs()->accept(this);
             string rhs = lastValue;
+            depth = max(depth, lastDepth);
 
-            print(expression->getType(), "concat", lhs, " + ", rhs);
+            print(expression->getType(), "shl", depth, lhs, " << ", rhs);
+        }
+
+        void JavaPrinter::visit(langd::semantic::Concatenation *expression) {
+            vector<semantic::Expression *> parts;
+            collectParts(expression, parts);
+
+            vector<string> values;
+            int depth = 0;
+            for (auto part: parts) {
+                part->accept(this);
+                values.push_back(lastValue);
+                depth = max(depth, lastDepth);
+            }
+
+            if (isHoistable(expression)) {
+                hoist(expression->getType(), join(values, " + "));
+                return;
+            }
+
+            if (values.size() <= MAX_CONCAT_PARTS) {
+                print(expression->getType(), "concat", depth, join(values, " + "), "");
+                return;
+            }
+
+            int capacity = 0;
+            for (auto part: parts) {
+                auto constant = dynamic_cast<semantic::StringConstant *>(part);
+                capacity += constant != nullptr ? constant->getValue().size() - 2 : 16;
+            }
+
+            auto builder = resolveName("builder");
+            out << prefix << "StringBuilder " << builder << " = new StringBuilder(" << capacity << ");" << '\n';
+            for (auto value: values) {
+                out << prefix << builder << ".append(" << value << ");" << '\n';
+            }
+
+            print(expression->getType(), "concat", MAX_NESTING, builder, ".toString()");
+        }
+
+        void JavaPrinter::collectParts(semantic::Expression *expression, vector<semantic::Expression *> &parts) {
+            if (auto concatenation = dynamic_cast<semantic::Concatenation *>(expression)) {
+                collectParts(concatenation->getLhs(), parts);
+                collectParts(concatenation->getRhs(), parts);
+                return;
+            }
+            parts.push_back(expression);
         }
 
         void JavaPrinter::visit(langd::semantic::Negation *expression) {
             expression->getExpression()->accept(this);
 
-            print(expression->getType(), "neg", " - ", lastValue);
+            print(expression->getType(), "neg", lastDepth, "- ", lastValue);
         }
 
         void JavaPrinter::visit(langd::semantic::StringConstant *expression) {
-            print(expression->getType(), "string", expression->getValue());
+            lastValue = expression->getValue();
+            lastDepth = 0;
         }
 
         void JavaPrinter::visit(langd::semantic::IntConstant *expression) {
-            print(expression->getType(), "int", to_string(expression->getValue()));
+            lastValue = to_string(expression->getValue());
+            lastDepth = 0;
         }
 
         void JavaPrinter::visit(langd::semantic::Tuple *expression) {
-            auto javaType = mapType(expression->getType());
-            auto javaName = resolveName("tuple");
-
-            cout << prefix << javaType << " " << javaName << " = new " << javaType << "();" << endl;
-            for (int i = 0; i < expression->getElements().size(); i++) {
-                auto element = expression->getElements()[i];
-
+            string arguments;
+            int depth = 0;
+            for (auto element: expression->getElements()) {
                 element.getExpression()->accept(this);
-                cout << prefix << javaName << ".e" << i << " = " << lastValue << ";" << endl;
+                arguments += (arguments.empty() ? "" : ", ") + lastValue;
+                depth = max(depth, lastDepth);
+            }
+
+            if (isHoistable(expression)) {
+                hoist(expression->getType(), "new " + mapType(expression->getType()) + "(" + arguments + ")");
+                return;
             }
 
-            lastValue = javaName;
+            print(expression->getType(), "tuple", depth, "new ", mapType(expression->getType()), "(", arguments + ")");
         }
 
         void JavaPrinter::visit(langd::semantic::MemberSelection *expression) {
+            auto tupleType = dynamic_cast<semantic::TupleType *>(expression->getExpression()->getType());
+            auto index = tupleType->indexOf(expression->getElement().getName());
+
             expression->getExpression()->accept(this);
-            print(expression->getType(), "select", lastValue, ".", expression->getElement().getName());
+            print(expression->getType(), "select", lastDepth, lastValue, ".e", to_string(index));
         }
 
         void JavaPrinter::visit(langd::semantic::FunctionCall *expression) {
+            string target = expression->getFunction() + ".apply(";
+            auto known = knownFunctions.find(expression->getFunction());
+            if (known != knownFunctions.end() && isStaticallyCallable(known->second)) {
+                target = functionClasses[known->second] + ".call(";
+            }
+
+            auto input = dynamic_cast<semantic::Tuple *>(expression->getInput());
+            if (input != nullptr && isFlattened(input->getType())) {
+                string arguments;
+                int depth = 0;
+                for (auto element: input->getElements()) {
+                    element.getExpression()->accept(this);
+                    arguments += (arguments.empty() ? "" : ", ") + lastValue;
+                    depth = max(depth, lastDepth);
+                }
+
+                print(expression->getType(), "result", depth, target, arguments, ")");
+                return;
+            }
+
+            if (target != expression->getFunction() + ".apply("
+                && isFlattened(dynamic_cast<semantic::TupleType *>(expression->getInput()->getType()))) {
+                target = functionClasses[known->second] + ".INSTANCE.apply(";
+            }
+
             expression->getInput()->accept(this);
-            print(expression->getType(), "result", expression->getFunction(), ".apply(", lastValue, ")");
+            print(expression->getType(), "result", lastDepth, target, lastValue, ")");
         }
 
         void JavaPrinter::visit(langd::semantic::FunctionDefinition *expression) {
-            auto functionJavaName = resolveName("Function");
+            captures[expression] = preciseCaptures(expression);
 
-            functions.emplace_back(functionJavaName, expression);
+            auto known = knownFunctions;
+            for (auto member: expression->getType()->getInputType()->getMembers()) {
+                known.erase(member.getName());
+            }
+            knownAtDefinition[expression] = known;
+
+            auto key = functionKey(expression);
+            auto identical = identicalFunctions.find(key);
+            semantic::FunctionDefinition *original = nullptr;
+            if (identical != identicalFunctions.end() && isLifted(expression)) {
+                original = identical->second;
+            } else {
+                identicalFunctions[key] = expression;
+            }
 
-            auto funcName = resolveName("func");
-            cout << prefix << functionJavaName << " " << funcName
-                 << " = new " << functionJavaName << "();" << endl;
+            if (captures[expression].empty()) {
+                if (original != nullptr) {
+                    functionClasses[expression] = functionClasses[original];
+                } else {
+                    functionClasses[expression] = functionClassName(key + "|" + declaredNames[expression]);
+                    functions.emplace_back(functionClasses[expression], expression);
+                }
 
-            for (auto variable: expression->getClosure()->getVariables()) {
-                cout << prefix << funcName << "." << variable->getName() << " = " << variable->getName() << ";" << endl;
+                record(functionClasses[expression]);
+                lastValue = functionClasses[expression] + ".INSTANCE";
+                lastDepth = 0;
+                return;
             }
 
+            if (environment.empty()) {
+                environment = "Env_" + codegen::toHex(codegen::stableHash(className + "#" + to_string(environmentCount++)));
+                classNames.reserve(environment);
+                live.insert(environment);
+                record(environment);
+                environmentLocal = resolveName("env");
+                environments[environment];
+                out << prefix << environment << " " << environmentLocal << " = new " << environment << "();" << '\n';
+            }
+
+            auto &fields = environments[environment];
+            for (auto variable: captures[expression]) {
+                if (environmentFields.insert(variable->getName()).second) {
+                    fields.emplace_back(variable->getName(), captureType(expression, variable));
+                    out << prefix << environmentLocal << "." << variable->getName() << " = " << variable->getName()
+                        << ";" << '\n';
+                }
+            }
+            functionEnvironments[expression] = environment;
+
+            if (original != nullptr && functionEnvironments[original] == environment
+                && sameCaptures(original, expression)) {
+                functionClasses[expression] = functionClasses[original];
+            } else {
+                string capturedNames;
+                for (auto variable: captures[expression]) {
+                    capturedNames += variable->getName() + ",";
+                }
+
+                string implementation;
+                if (original != nullptr) {
+                    implementation = functionClasses[original];
+                    sharedImplementations[expression] = implementation;
+                }
+                functionClasses[expression] = functionClassName(key + "|" + declaredNames[expression] + "|"
+                                                                + environment + "|" + capturedNames + "|"
+                                                                + implementation);
+                functions.emplace_back(functionClasses[expression], expression);
+            }
+            record(functionClasses[expression]);
+
+            auto funcName = resolveName("func");
+            out << prefix << functionClasses[expression] << " " << funcName
+                 << " = new " << functionClasses[expression] << "(" << environmentLocal << ");" << '\n';
+
             lastValue = funcName;
+            lastDepth = 0;
+        }
+
+        string JavaPrinter::functionClassName(string key) {
+            auto name = "Function_" + codegen::toHex(codegen::stableHash(key));
+            if (classNames.isTaken(name)) {
+                return classNames.allocate(name);
+            }
+
+            classNames.reserve(name);
+            return name;
         }
 
-        void
-        JavaPrinter::print(semantic::Type *type, string name, string code, string code2, string code3, string code4) {
+        bool JavaPrinter::sameCaptures(semantic::FunctionDefinition *first, semantic::FunctionDefinition *second) {
+            if (captures[first].size() != captures[second].size()) {
+                return false;
+            }
+
+            for (int i = 0; i < captures[first].size(); i++) {
+                if (captures[first][i]->getName() != captures[second][i]->getName()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        vector<semantic::Variable *> JavaPrinter::preciseCaptures(semantic::FunctionDefinition *definition) {
+            ValueReferences values;
+            values.transform(definition->getBody());
+
+            vector<semantic::Variable *> result;
+            for (auto variable: definition->getClosure()->getVariables()) {
+                auto known = knownFunctions.find(variable->getName());
+                bool calledOnly = values.names.count(variable->getName()) == 0;
+                if (known == knownFunctions.end() || !calledOnly || !isStaticallyCallable(known->second)) {
+                    result.push_back(variable);
+                }
+            }
+            return result;
+        }
+
+        string JavaPrinter::functionKey(semantic::FunctionDefinition *definition) {
+            map<string, string> names;
+            auto members = definition->getType()->getInputType()->getMembers();
+            for (int i = 0; i < members.size(); i++) {
+                names[members[i].getName()] = "p" + to_string(i);
+            }
+
+            string key = typeMapper->map(definition->getType()) + ";";
+            auto closure = captures[definition];
+            for (int i = 0; i < closure.size(); i++) {
+                names[closure[i]->getName()] = "c" + to_string(i);
+                key += captureType(definition, closure[i]) + ",";
+            }
+
+            for (auto known: knownAtDefinition[definition]) {
+                if (names.count(known.first) == 0) {
+                    names[known.first] = functionClasses[known.second];
+                }
+            }
+
+            FunctionKey functionKey(typeMapper, names);
+            definition->getBody()->accept(&functionKey);
+
+            string declared;
+            for (auto member: members) {
+                declared += member.getName() + ",";
+            }
+            declaredNames[definition] = declared + functionKey.declared;
+            return key + ";" + functionKey.key;
+        }
+
+        string JavaPrinter::captureType(semantic::FunctionDefinition *definition, semantic::Variable *variable) {
+            auto known = knownAtDefinition[definition].find(variable->getName());
+            if (known != knownAtDefinition[definition].end()) {
+                return functionClasses[known->second];
+            }
+            return typeMapper->map(variable->getType());
+        }
+
+        void JavaPrinter::print(semantic::Type *type, string name, int depth, string code, string code2,
+                                string code3, string code4) {
+            if (depth < MAX_NESTING) {
+                lastValue = "(" + code + code2 + code3 + code4 + ")";
+                lastDepth = depth + 1;
+                return;
+            }
+
             lastValue = resolveName(name);
-            cout << prefix << mapType(type) << " " << lastValue << " = ";
-            cout << code << code2 << code3 << code4 << ";" << endl;
+            lastDepth = 0;
+            out << prefix << mapType(type) << " " << lastValue << " = ";
+            out << code << code2 << code3 << code4 << ";" << '\n';
+        }
+
+        void JavaPrinter::hoist(semantic::Type *type, string code) {
+            auto name = "CONST_" + codegen::toHex(codegen::stableHash(code));
+            auto field = "static final " + mapType(type) + " " + name + " = " + code + ";";
+            if (constantNames.insert(name).second) {
+                constantFields.push_back(field);
+            }
+            if (cache != nullptr && className != "LangD") {
+                cache->addConstant(className, name, field);
+            }
+
+            lastValue = directory.empty() ? name : "Constants." + name;
+            lastDepth = 0;
         }
 
         std::string JavaPrinter::mapType(semantic::Type *type) {
             return typeMapper->map(type);
         }
 
-        string JavaPrinter::resolveName(string name) {
-            for (int i = 0; true; i++) {
-                auto newName = name + "_" + to_string(i);
-                if (isNewName(newName)) {
-                    names.push_back(newName);
-                    return newName;
-                }
-            }
+        void JavaPrinter::beginMethod(string name, string returnType, bool isStatic) {
+            locals.clear();
+            methodName = name;
+            this->returnType = returnType;
+            staticMethod = isStatic;
+            methodStart = out.getWritten();
+            environment.clear();
+            environmentFields.clear();
         }
 
-        bool JavaPrinter::isNewName(std::string newName) {
-            for (string name : names) {
-                if (name == newName) {
-                    return false;
+        bool JavaPrinter::splitMethod(vector<string> liveLocals) {
+            if (liveLocals.size() > MAX_PARAMETERS) {
+                return false;
+            }
+
+            string arguments;
+            string parameters;
+            map<string, string> liveTypes;
+            for (auto name: liveLocals) {
+                if (!arguments.empty()) {
+                    arguments += ", ";
+                    parameters += ", ";
                 }
+                arguments += name;
+                parameters += locals[name] + " " + name;
+                liveTypes[name] = locals[name];
             }
+
+            auto helperName = resolveName(methodName);
+            auto methodPrefix = prefix.substr(4);
+
+            out << prefix << (returnType == "void" ? "" : "return ") << helperName << "(" << arguments << ");" << '\n';
+            out << methodPrefix << "}" << '\n';
+            out << '\n';
+            out << methodPrefix << "private " << (staticMethod ? "static " : "") << returnType << " " << helperName;
+            out << "(" << parameters << ") {" << '\n';
+
+            locals = liveTypes;
+            methodStart = out.getWritten();
+            environment.clear();
+            environmentFields.clear();
             return true;
         }
 
@@ -175,47 +782,142 @@ namespace langd {
                 auto javaName = function.first;
                 auto definition = function.second;
                 auto type = definition->getType();
+                auto closure = captures[definition];
+                knownFunctions = knownAtDefinition[definition];
+
+                if (reuseCachedClass(javaName)) {
+                    continue;
+                }
 
-                cout << "    private static class " << javaName;
-                cout << " implements " << typeMapper->map(definition->getType()) << " {" << endl;
+                beginClassBody(javaName);
+                beginClass(javaName);
+                out << nestedModifiers() << "final class " << javaName;
+                out << " implements " << typeMapper->map(definition->getType()) << " {" << '\n';
 
-                for (auto variable: definition->getClosure()->getVariables()) {
-                    cout << "        public " << typeMapper->map(variable->getType()) << " "
-                         << variable->getName() << ";" << endl;
+                if (closure.empty()) {
+                    out << "        public static final " << javaName << " INSTANCE = new " << javaName << "();" << '\n';
                 }
 
-                cout << endl;
+                if (!closure.empty()) {
+                    auto environmentType = functionEnvironments[definition];
+                    out << "        private final " << environmentType << " env;" << '\n';
+                    out << '\n';
+                    out << "        public " << javaName << "(" << environmentType << " env) {" << '\n';
+                    out << "            this.env = env;" << '\n';
+                    out << "        }" << '\n';
+                }
 
-                cout << "        public " << typeMapper->map(type->getOutputType());
-                cout << " apply(";
-                cout << typeMapper->map(type->getInputType());
-                cout << " _input) {" << endl;
+                out << '\n';
 
+                auto outputType = typeMapper->map(type->getOutputType());
                 auto members = type->getInputType()->getMembers();
+                bool flattened = isFlattened(type->getInputType());
+
+                string parameters;
+                string arguments;
+                if (flattened) {
+                    for (auto member: members) {
+                        parameters += (parameters.empty() ? "" : ", ") + typeMapper->map(member.getType()) + " "
+                                      + member.getName();
+                        arguments += (arguments.empty() ? "" : ", ") + member.getName();
+                    }
+                } else {
+                    parameters = typeMapper->map(type->getInputType()) + " _input";
+                    arguments = "_input";
+                }
+
+                string closureParameters;
+                string closureArguments;
+                for (auto variable: closure) {
+                    closureParameters += captureType(definition, variable) + " " + variable->getName() + ", ";
+                    closureArguments += "this.env." + variable->getName() + ", ";
+                }
+
+                auto shared = sharedImplementations.find(definition);
+                if (shared != sharedImplementations.end()) {
+                    out << "        public " << outputType << " apply(" << parameters << ") {" << '\n';
+                    out << "            return " << shared->second << ".call(" << closureArguments << arguments << ");"
+                        << '\n';
+                    out << "        }" << '\n';
+                    endClass();
+                    continue;
+                }
+
+                if (isLifted(definition)) {
+                    out << "        public " << outputType << " apply(" << parameters << ") {" << '\n';
+                    out << "            return call(" << closureArguments << arguments << ");" << '\n';
+                    out << "        }" << '\n';
+                    out << '\n';
+                    out << "        public static " << outputType << " call(" << closureParameters << parameters
+                        << ") {" << '\n';
+                    beginMethod("call", outputType, true);
+
+                    for (auto variable: closure) {
+                        locals[variable->getName()] = captureType(definition, variable);
+                    }
+                } else {
+                    out << "        public " << outputType << " apply(" << parameters << ") {" << '\n';
+                    beginMethod("apply", outputType, false);
+
+                    for (auto variable: closure) {
+                        auto variableType = captureType(definition, variable);
+                        out << "            " << variableType << " " << variable->getName() << " = this.env."
+                            << variable->getName() << ";" << '\n';
+                        locals[variable->getName()] = variableType;
+                    }
+                }
+
                 for (int i = 0; i < members.size(); i++) {
                     auto member = members[i];
+                    auto memberType = typeMapper->map(member.getType());
 
-                    cout << "            " << typeMapper->map(member.getType()) << " " << member.getName()
-                         << " = _input.e" << to_string(i) << ";" << endl;
+                    if (!flattened) {
+                        out << "            " << memberType << " " << member.getName()
+                             << " = _input.e" << to_string(i) << ";" << '\n';
+                    }
+                    locals[member.getName()] = memberType;
                 }
 
                 definition->getBody()->accept(this);
 
-                cout << "            return " << lastValue << ";" << endl;
-                cout << "        }" << endl;
+                out << "            return " << lastValue << ";" << '\n';
+                out << "        }" << '\n';
 
-                cout << "    }" << endl;
+                endClass();
             }
         }
 
         void JavaPrinter::printTupleTypes() {
             for (auto tuple: typeMapper->getTupleTypes()) {
-                cout << "    private static class " << tuple.first << " {" << endl;
+                beginClass(tuple.first);
+                printStructure(tuple.first);
+                out << nestedModifiers() << "class " << tuple.first << " {" << '\n';
                 auto members = tuple.second->getMembers();
+                string parameters;
+                for (int i = 0; i < members.size(); i++) {
+                    auto memberType = typeMapper->map(members[i].getType());
+                    out << "        public final " << memberType << " e" << i << ";" << '\n';
+                    parameters += (i == 0 ? "" : ", ") + memberType + " e" + to_string(i);
+                }
+
+                out << '\n';
+                out << "        public " << tuple.first << "(" << parameters << ") {" << '\n';
                 for (int i = 0; i < members.size(); i++) {
-                    cout << "        public " << typeMapper->map(members[i].getType()) << " e" << i << ";" << endl;
+                    out << "            this.e" << i << " = e" << i << ";" << '\n';
+                }
+                out << "        }" << '\n';
+                endClass();
+            }
+        }
+
+        void JavaPrinter::printEnvironments() {
+            for (auto environment: environments) {
+                beginClass(environment.first);
+                out << nestedModifiers() << "final class " << environment.first << " {" << '\n';
+                for (auto field: environment.second) {
+                    out << "        public " << field.second << " " << field.first << ";" << '\n';
                 }
-                cout << "    }" << endl;
+                endClass();
             }
         }
 
@@ -223,22 +925,58 @@ namespace langd {
             for (auto function: typeMapper->getFunctionTypes()) {
                 auto type = function.second;
 
-                cout << "    private static interface " << function.first << " {" << endl;
+                beginClass(function.first);
+                printStructure(function.first);
+                out << nestedModifiers() << "interface " << function.first << " {" << '\n';
+
+                auto outputType = typeMapper->map(type->getOutputType());
+                auto inputType = typeMapper->map(type->getInputType());
+                if (isFlattened(type->getInputType())) {
+                    auto members = type->getInputType()->getMembers();
+                    string parameters;
+                    string arguments;
+                    for (int i = 0; i < members.size(); i++) {
+                        parameters += (i == 0 ? "" : ", ") + typeMapper->map(members[i].getType()) + " e" + to_string(i);
+                        arguments += (i == 0 ? "" : ", ") + string("_input.e") + to_string(i);
+                    }
+
+                    out << "        public " << outputType << " apply(" << parameters << ");" << '\n';
+                    out << '\n';
+                    out << "        public default " << outputType << " apply(" << inputType << " _input) {" << '\n';
+                    out << "            return apply(" << arguments << ");" << '\n';
+                    out << "        }" << '\n';
+                } else {
+                    out << "        public " << outputType << " apply(" << inputType << " _input);" << '\n';
+                }
 
-                cout << "        public " << typeMapper->map(type->getOutputType());
-                cout << " apply(";
-                cout << typeMapper->map(type->getInputType());
-                cout << " _input);" << endl;
+                endClass();
+            }
+        }
 
-                cout << "    }" << endl;
+        void JavaPrinter::printStructure(string javaName) {
+            auto structure = typeMapper->getStructure(javaName);
+            if (!structure.empty()) {
+                out << "    // " << javaName << " = " << structure << '\n';
             }
         }
 
         TypeMapper::TypeMapper() : compositeTypeMapper(new CompositeTypeMapper) {}
 
+        TypeMapper::~TypeMapper() {
+            delete compositeTypeMapper;
+        }
+
         string TypeMapper::map(semantic::Type *type) {
-            type->accept(this);
-            return javaType;
+            auto cached = javaTypes.find(type);
+            if (cached == javaTypes.end()) {
+                type->accept(this);
+                cached = javaTypes.emplace(type, javaType).first;
+            }
+
+            if (dynamic_cast<semantic::TupleType *>(type) || dynamic_cast<semantic::FunctionType *>(type)) {
+                used.insert(cached->second);
+            }
+            return cached->second;
         }
 
         void TypeMapper::visit(semantic::VoidType *type) {
@@ -263,52 +1001,67 @@ namespace langd {
 
 
         std::string CompositeTypeMapper::map(semantic::Type *type) {
-            javaName = "";
+            auto cached = javaNames.find(type);
+            if (cached != javaNames.end()) {
+                return cached->second;
+            }
+
             type->accept(this);
+            javaNames[type] = javaName;
             return javaName;
         }
 
         void CompositeTypeMapper::visit(semantic::VoidType *type) {
-            javaName += "V";
+            javaName = "V";
         }
 
         void CompositeTypeMapper::visit(semantic::StringType *type) {
-            javaName += "S";
+            javaName = "S";
         }
 
         void CompositeTypeMapper::visit(semantic::IntegerType *type) {
-            javaName += "I";
+            javaName = "I";
         }
 
         void CompositeTypeMapper::visit(semantic::TupleType *type) {
-            auto javaNameBeforeThisTuple = javaName;
-            javaName = "T" + to_string(type->getMembers().size());
+            auto kind = "T" + to_string(type->getMembers().size());
+            auto structure = kind;
             for (auto member: type->getMembers()) {
-                javaName += "_";
-                member.getType()->accept(this);
+                structure += "_" + map(member.getType());
             }
 
-            auto javaNameOfThisTuple = javaName;
+            auto javaNameOfThisTuple = shorten(kind, structure);
+
             if (tuples.count(javaNameOfThisTuple) == 0) {
                 tuples[javaNameOfThisTuple] = type;
             }
 
-            javaName = javaNameBeforeThisTuple + javaNameOfThisTuple;
+            javaName = javaNameOfThisTuple;
         }
 
         void CompositeTypeMapper::visit(semantic::FunctionType *type) {
-            auto javaNameBeforeThisFunction = javaName;
-            javaName = "F_";
-            type->getInputType()->accept(this);
-            javaName += "_";
-            type->getOutputType()->accept(this);
+            auto structure = "F_" + map(type->getInputType()) + "_" + map(type->getOutputType());
+            auto javaNameOfThisFunction = shorten("F", structure);
 
-            auto javaNameOfThisFunction = javaName;
             if (functions.count(javaNameOfThisFunction) == 0) {
                 functions[javaNameOfThisFunction] = type;
             }
 
-            javaName = javaNameBeforeThisFunction + javaNameOfThisFunction;
+            javaName = javaNameOfThisFunction;
+        }
+
+        string CompositeTypeMapper::shorten(string kind, string structure) {
+            if (structure.size() <= MAX_NAME_LENGTH) {
+                return structure;
+            }
+
+            auto hashedName = kind + "_" + codegen::toHex(codegen::stableHash(structure));
+            for (int salt = 1; structures.count(hashedName) != 0 && structures[hashedName] != structure; salt++) {
+                hashedName = kind + "_" + codegen::toHex(codegen::stableHash(structure + "#" + to_string(salt)));
+            }
+
+            structures[hashedName] = structure;
+            return hashedName;
         }
     }
 }
\ No newline at end of file
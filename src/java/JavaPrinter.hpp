@@ -7,8 +7,13 @@
 
 #include <map>
 #include <list>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 
+#include <codegen/ClassCache.hpp>
+#include <codegen/NameAllocator.hpp>
+#include <codegen/Output.hpp>
 #include <semantic/ExpressionVisitor.hpp>
 #include <semantic/Expression.hpp>
 
@@ -19,9 +24,28 @@ namespace langd {
 
         class JavaPrinter : public semantic::ExpressionVisitor {
         public:
-            JavaPrinter();
+            explicit JavaPrinter(codegen::Output &out);
+
+            JavaPrinter(codegen::Output &out, std::string directory);
+
+            JavaPrinter(const JavaPrinter &) = delete;
+
+            ~JavaPrinter();
+
             void print(semantic::Block *block);
 
+            void setCache(codegen::ClassCache *cache) {
+                this->cache = cache;
+            }
+
+            int getCacheHits() {
+                return cacheHits;
+            }
+
+            int getCacheMisses() {
+                return cacheMisses;
+            }
+
             void visit(semantic::Block *block) override;
 
             void visit(semantic::Assignment *assignment) override;
@@ -34,6 +58,8 @@ namespace langd {
 
             void visit(semantic::TimesOperation *expression) override;
 
+            void visit(semantic::ShiftLeftOperation *expression) override;
+
             void visit(semantic::Concatenation *expression) override;
 
             void visit(semantic::Negation *expression) override;
@@ -51,38 +77,131 @@ namespace langd {
             void visit(semantic::FunctionDefinition *expression) override;
 
         private:
+            codegen::Output &out;
             TypeMapper *typeMapper;
-            std::vector<std::string> names;
+            codegen::NameAllocator names;
+            codegen::NameAllocator classNames;
+            std::string directory;
+            std::string className;
+            int environmentCount = 0;
+            codegen::ClassCache *cache = nullptr;
+            codegen::ClassCache *ownedCache = nullptr;
+            std::set<std::string> live;
+            int cacheHits = 0;
+            int cacheMisses = 0;
             std::string lastValue;
+            int lastDepth = 0;
 
             std::list<std::pair<std::string, semantic::FunctionDefinition*>> functions;
+            std::map<std::string, semantic::FunctionDefinition *> knownFunctions;
+            std::unordered_map<semantic::FunctionDefinition *, std::string> functionClasses;
+            std::unordered_map<semantic::FunctionDefinition *, std::map<std::string, semantic::FunctionDefinition *>> knownAtDefinition;
+            std::unordered_map<semantic::FunctionDefinition *, std::vector<semantic::Variable *>> captures;
+            std::unordered_map<semantic::FunctionDefinition *, std::string> functionEnvironments;
+            std::unordered_map<std::string, semantic::FunctionDefinition *> identicalFunctions;
+            std::unordered_map<semantic::FunctionDefinition *, std::string> sharedImplementations;
+            std::unordered_map<semantic::FunctionDefinition *, std::string> declaredNames;
+            std::map<std::string, std::vector<std::pair<std::string, std::string>>> environments;
+            std::string environment;
+            std::string environmentLocal;
+            std::set<std::string> environmentFields;
 
             std::string prefix = "        ";
 
-            void print(semantic::Type *type, std::string name, std::string code) {
-                print(type, name, code, "");
-            }
+            static const int MAX_NESTING = 8;
+            static const size_t MAX_METHOD_SIZE = 16000;
+            static const size_t MAX_PARAMETERS = 200;
+            static const size_t MAX_CONCAT_PARTS = 200;
+
+            std::map<std::string, std::string> locals;
+            std::string methodName;
+            std::string returnType;
+            bool staticMethod;
+            size_t methodStart;
 
-            void print(semantic::Type *type, std::string name, std::string code, std::string code2) {
-                print(type, name, code, code2, "");
+            void print(semantic::Type *type, std::string name, int depth, std::string code, std::string code2) {
+                print(type, name, depth, code, code2, "");
             }
 
-            void print(semantic::Type *type, std::string name, std::string code, std::string code2, std::string code3) {
-                print(type, name, code, code2, code3, "");
+            void print(semantic::Type *type, std::string name, int depth, std::string code, std::string code2,
+                       std::string code3) {
+                print(type, name, depth, code, code2, code3, "");
             }
 
-            void print(semantic::Type *type, std::string name, std::string code, std::string code2, std::string code3, std::string code4);
+            void print(semantic::Type *type, std::string name, int depth, std::string code, std::string code2,
+                       std::string code3, std::string code4);
+
+            std::set<std::string> constantNames;
+            std::vector<std::string> constantFields;
+
+            void hoist(semantic::Type *type, std::string code);
+
+            void collectParts(semantic::Expression *expression, std::vector<semantic::Expression *> &parts);
 
             std::string mapType(semantic::Type *type);
 
-            std::string resolveName(std::string name);
+            void beginMethod(std::string name, std::string returnType, bool isStatic);
+
+            bool splitMethod(std::vector<std::string> liveLocals);
+
+            bool isFlattened(semantic::TupleType *inputType) {
+                return inputType->getMembers().size() <= MAX_PARAMETERS;
+            }
+
+            bool isLifted(semantic::FunctionDefinition *definition) {
+                auto inputType = definition->getType()->getInputType();
+                auto parameters = isFlattened(inputType) ? inputType->getMembers().size() : 1;
+                return captures[definition].size() + parameters <= MAX_PARAMETERS;
+            }
+
+            bool isStaticallyCallable(semantic::FunctionDefinition *definition) {
+                return captures[definition].empty() && isLifted(definition);
+            }
+
+            std::vector<semantic::Variable *> preciseCaptures(semantic::FunctionDefinition *definition);
+
+            std::string captureType(semantic::FunctionDefinition *definition, semantic::Variable *variable);
+
+            std::string functionKey(semantic::FunctionDefinition *definition);
 
-            bool isNewName(std::string name);
+            std::string functionClassName(std::string key);
+
+            bool sameCaptures(semantic::FunctionDefinition *first, semantic::FunctionDefinition *second);
+
+            std::string resolveName(std::string name) {
+                return names.allocate(name);
+            }
+
+            void beginClass(std::string name);
+
+            void beginClassBody(std::string name);
+
+            void record(std::string dependency);
+
+            void recordTypes();
+
+            void recordTypeStructure();
+
+            bool reuseCachedClass(std::string name);
+
+            void markLive(std::string name);
+
+            void removeStaleClasses();
+
+            void endClass();
+
+            std::string nestedModifiers();
+
+            void printConstants();
 
             void printTupleTypes();
 
+            void printEnvironments();
+
             void printFunctionTypes();
 
+            void printStructure(std::string javaName);
+
             void printFunctions();
         };
 
@@ -108,16 +227,31 @@ namespace langd {
                 return functions;
             }
 
+            std::string getStructure(std::string javaName) {
+                auto structure = structures.find(javaName);
+                return structure == structures.end() ? "" : structure->second;
+            }
+
         private:
+            static const size_t MAX_NAME_LENGTH = 48;
+
             std::string javaName;
+            std::map<std::string, std::string> structures;
+            std::unordered_map<semantic::Type *, std::string> javaNames;
             std::map<std::string, semantic::TupleType*> tuples;
             std::map<std::string, semantic::FunctionType*> functions;
+
+            std::string shorten(std::string kind, std::string structure);
         };
 
         class TypeMapper : public semantic::TypeVisitor {
         public:
             TypeMapper();
 
+            TypeMapper(const TypeMapper &) = delete;
+
+            ~TypeMapper();
+
             std::string map(semantic::Type *type);
 
             void visit(semantic::VoidType *type) override;
@@ -137,8 +271,20 @@ namespace langd {
             std::map<std::string, semantic::FunctionType *> getFunctionTypes() {
                 return compositeTypeMapper->getFunctions();
             }
+
+            std::string getStructure(std::string javaName) {
+                return compositeTypeMapper->getStructure(javaName);
+            }
+
+            std::set<std::string> takeUsed() {
+                auto result = used;
+                used.clear();
+                return result;
+            }
         private:
             std::string javaType;
+            std::set<std::string> used;
+            std::unordered_map<semantic::Type *, std::string> javaTypes;
             CompositeTypeMapper* compositeTypeMapper;
         };
 
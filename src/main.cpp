@@ -2,29 +2,194 @@
 #include "parser.hpp"
 #include "printer.hpp"
 #include <iostream>
+#include <map>
+#include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <codegen/Output.hpp>
 #include <semantic/Analyser.hpp>
+#include <semantic/NodePool.hpp>
+#include <semantic/PassManager.hpp>
 #include <java/JavaPrinter.hpp>
+#include <server/Server.hpp>
 
 
 using namespace std;
+using namespace langd::codegen;
 using namespace langd::java;
 using namespace langd;
 
-extern Block* parsedProgram;
+typedef struct yy_buffer_state *YY_BUFFER_STATE;
+extern int yylex_init_extra(ostream *errors, yyscan_t *scanner);
+extern int yylex_destroy(yyscan_t scanner);
+extern YY_BUFFER_STATE yy_scan_string(const char *source, yyscan_t scanner);
 
-int main() {
-    int result = yyparse();
+struct Options {
+    string outputPath;
+    string directory;
+    string socketPath;
+    int optimizationLevel = 2;
+    bool verify = false;
+    bool printStatistics = false;
+};
+
+struct Directory {
+    mutex lock;
+    ClassCache *cache = nullptr;
+};
+
+map<string, Directory> directories;
+mutex directoriesLock;
+bool keepClassCaches = false;
+const int VERIFICATION_FAILED = 3;
+
+Directory &directoryFor(string path) {
+    lock_guard<mutex> lock(directoriesLock);
+    return directories[path];
+}
+
+bool parseOptions(vector<string> arguments, Options &options) {
+    for (int i = 0; i < arguments.size(); i++) {
+        string arg = arguments[i];
+        if (arg == "-o" && i + 1 < arguments.size()) {
+            options.outputPath = arguments[++i];
+        } else if (arg == "-d" && i + 1 < arguments.size()) {
+            options.directory = arguments[++i];
+        } else if (arg == "--server" && i + 1 < arguments.size()) {
+            options.socketPath = arguments[++i];
+        } else if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+            options.optimizationLevel = arg[2] - '0';
+        } else if (arg == "--verify") {
+            options.verify = true;
+        } else if (arg == "--stats") {
+            options.printStatistics = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int compile(yyscan_t scanner, Output &out, Options &options, ClassCache *cache, ostream &errors) {
+    semantic::NodePool nodes;
+
+    Block *program = nullptr;
+    int result = yyparse(scanner, &program);
+    unique_ptr<Block> parsedProgram(program);
     if(result == 0) {
-        cout << "/*" << endl;
-        Printer* printer = new Printer();
-        printer->print(parsedProgram);
-        cout << "*/" << endl;
+        out << "/*" << '\n';
+        Printer printer(out);
+        printer.print(parsedProgram.get());
+        out << "*/" << '\n';
+
+        semantic::Analyser analyser;
+        auto analysedBlock = analyser.analyse(parsedProgram.get());
+
+        semantic::PassManager passManager(options.optimizationLevel);
+        passManager.setVerify(options.verify);
+        if (options.printStatistics) {
+            passManager.setStatistics(&errors);
+        }
+        try {
+            analysedBlock = passManager.run(analysedBlock);
+        } catch (logic_error &error) {
+            errors << error.what() << endl;
+            out.flush();
+            return VERIFICATION_FAILED;
+        }
+
+        JavaPrinter javaPrinter(out, options.directory);
+        if (cache != nullptr) {
+            javaPrinter.setCache(cache);
+        }
+        javaPrinter.print(analysedBlock);
+        if (options.printStatistics && !options.directory.empty()) {
+            errors << "class cache: " << javaPrinter.getCacheHits() << " hits, "
+                   << javaPrinter.getCacheMisses() << " misses" << endl;
+        }
+    }
+    out.flush();
+    return result;
+}
+
+int compileTo(yyscan_t scanner, Output &standardOutput, Options &options, ostream &errors) {
+    if (!options.directory.empty()) {
+        if (mkdir(options.directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            errors << "Could not create " << options.directory << ": " << strerror(errno) << endl;
+            return 1;
+        }
+
+        auto &directory = directoryFor(options.directory);
+        lock_guard<mutex> lock(directory.lock);
+        if (keepClassCaches && directory.cache == nullptr) {
+            directory.cache = new ClassCache(options.directory + "/.langd-cache");
+            directory.cache->load();
+        }
+
+        Output out(options.directory + "/LangD.java");
+        return compile(scanner, out, options, directory.cache, errors);
+    }
+
+    if (options.outputPath.empty()) {
+        return compile(scanner, standardOutput, options, nullptr, errors);
+    }
+
+    Output out(options.outputPath);
+    return compile(scanner, out, options, nullptr, errors);
+}
+
+int compileRequest(vector<string> arguments, string source, Output &out, ostream &errors) {
+    Options options;
+    if (!parseOptions(arguments, options) || !options.socketPath.empty()) {
+        errors << "Unsupported request options" << endl;
+        return 2;
+    }
+
+    yyscan_t scanner;
+    yylex_init_extra(&errors, &scanner);
+    yy_scan_string(source.c_str(), scanner);
+
+    int result;
+    try {
+        result = compileTo(scanner, out, options, errors);
+    } catch (...) {
+        yylex_destroy(scanner);
+        throw;
+    }
+    yylex_destroy(scanner);
+
+    if (result != 0 && result != VERIFICATION_FAILED) {
+        errors << "Could not parse input" << endl;
+    }
+    return result;
+}
 
-        semantic::Analyser* analyser = new semantic::Analyser();
-        auto analysedBlock = analyser->analyse(parsedProgram);
-        
-        JavaPrinter* javaPrinter = new JavaPrinter();
-        javaPrinter->print(analysedBlock);
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(vector<string>(argv + 1, argv + argc), options)) {
+        cerr << "Usage: " << argv[0] << " [-o output | -d directory | --server socket] [-O0|-O1|-O2] [--verify] [--stats]"
+             << endl;
+        return 2;
     }
+
+    if (!options.socketPath.empty()) {
+        keepClassCaches = true;
+        server::Server server(options.socketPath, compileRequest);
+        server.run();
+        return 0;
+    }
+
+    yyscan_t scanner;
+    yylex_init_extra(&cerr, &scanner);
+
+    Output out(STDOUT_FILENO);
+    int result = compileTo(scanner, out, options, cerr);
+    yylex_destroy(scanner);
     return result;
 }
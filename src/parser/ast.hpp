@@ -99,6 +99,8 @@ namespace langd {
 
         class Expression {
         public:
+            virtual ~Expression() = default;
+
             virtual void accept(ExpressionVisitor *visitor) = 0;
         };
 
@@ -108,6 +110,12 @@ namespace langd {
 
             Block(vector<Expression *> expressions) : expressions(expressions) {}
 
+            ~Block() override {
+                for (auto expression: expressions) {
+                    delete expression;
+                }
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -122,6 +130,10 @@ namespace langd {
                     id(id),
                     expression(expression) {}
 
+            ~Assignment() override {
+                delete expression;
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -136,6 +148,8 @@ namespace langd {
                     id(id),
                     type(type) {}
 
+            ~TypeAssignment() override;
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -147,6 +161,11 @@ namespace langd {
             Expression *rhs;
 
             BinaryOp(Expression *lhs, Expression *rhs) : lhs(lhs), rhs(rhs) {}
+
+            ~BinaryOp() override {
+                delete lhs;
+                delete rhs;
+            }
         };
 
         class PlusOp : public BinaryOp {
@@ -182,6 +201,10 @@ namespace langd {
 
             Negation(Expression *expression) : expression(expression) {}
 
+            ~Negation() override {
+                delete expression;
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -216,6 +239,12 @@ namespace langd {
 
             Tuple(vector<Assignment *> assignments) : assignments(assignments) {}
 
+            ~Tuple() override {
+                for (auto assignment: assignments) {
+                    delete assignment;
+                }
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -230,6 +259,10 @@ namespace langd {
                     previousExpression(previousExpression),
                     id(id) {}
 
+            ~MemberSelection() override {
+                delete previousExpression;
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -243,6 +276,8 @@ namespace langd {
             FunctionDefinition(TupleType *inputType, Expression *body) :
                     inputType(inputType), body(body) {}
 
+            ~FunctionDefinition() override;
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -255,6 +290,10 @@ namespace langd {
 
             FunctionCall(string id, Expression *parameter) : id(id), parameter(parameter) {}
 
+            ~FunctionCall() override {
+                delete parameter;
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -268,6 +307,10 @@ namespace langd {
                     FunctionCall(id, parameter),
                     precedingExpression(precedingExpression) {}
 
+            ~InfixFunctionCall() override {
+                delete precedingExpression;
+            }
+
             void accept(ExpressionVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -275,6 +318,8 @@ namespace langd {
 
         class Type {
         public:
+            virtual ~Type() = default;
+
             virtual void accept(TypeVisitor *visitor) = 0;
 
             bool virtual operator==(Type &other) = 0;
@@ -323,6 +368,12 @@ namespace langd {
 
             TupleType(vector<TypedId> members) : members(members) {}
 
+            ~TupleType() override {
+                for (auto member: members) {
+                    delete member.type;
+                }
+            }
+
             bool virtual operator==(Type &other) {
                 TupleType *tupleType = dynamic_cast<TupleType *>(&other);
                 if (tupleType == nullptr) {
@@ -354,6 +405,11 @@ namespace langd {
 
             FunctionType(Type *inputType, Type *outputType) : inputType(inputType), outputType(outputType) {}
 
+            ~FunctionType() override {
+                delete inputType;
+                delete outputType;
+            }
+
             virtual void accept(TypeVisitor *visitor) {
                 visitor->visit(this);
             }
@@ -370,5 +426,14 @@ namespace langd {
             }
 
         };
+
+        inline TypeAssignment::~TypeAssignment() {
+            delete type;
+        }
+
+        inline FunctionDefinition::~FunctionDefinition() {
+            delete inputType;
+            delete body;
+        }
     }
 }
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "printer.hpp"
-#include <iostream>
 
 using namespace std;
 
@@ -8,7 +7,7 @@ void Printer::print(Block* block) {
 }
 
 void Printer::printElement(string element) {
-    cout << rootPrefix << element << endl;
+    out << rootPrefix << element << '\n';
 }
 
 template<class T> void Printer::printUnary(string op, T* param) {
@@ -48,7 +47,7 @@ template<class L, class R> void Printer::printBinary(string op, L* lhs, R* rhs)
     afterRootPrefix = oldBeforeRootPrefix + "|   ";
     lhs->accept(this);
 
-    cout << oldRootPrefix << op << endl;
+    out << oldRootPrefix << op << '\n';
 
     beforeRootPrefix = oldAfterRootPrefix + "|   ";
     rootPrefix = oldAfterRootPrefix + "\\-- ";
@@ -69,7 +68,7 @@ template <typename T> void Printer::printList(string op, vector<T> list) {
     rootPrefix = oldAfterRootPrefix + "|-- ";
     afterRootPrefix = oldAfterRootPrefix + "|   ";
 
-    cout << oldRootPrefix << op << endl;
+    out << oldRootPrefix << op << '\n';
 
     for(T item: list) {
         printItem(item);
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "parser/ast.hpp"
+#include "codegen/Output.hpp"
 
 using namespace langd::parser;
 
 class Printer: public ExpressionVisitor, public TypeVisitor {
 private:
+    langd::codegen::Output &out;
+
     string beforeRootPrefix = "";
     string afterRootPrefix = "";
     string rootPrefix = "";
@@ -17,6 +20,8 @@ private:
     template <class T> void printUnary(string op, T* param);
     template <class L, class R> void printBinary(string op, L* lhs, R* rhs);
 public:
+    explicit Printer(langd::codegen::Output &out) : out(out) {}
+
     void print(Block* block);
 
     virtual void visit(Block* block);
@@ -2,6 +2,7 @@
 // Created by xtrit on 31/07/17.
 //
 
+#include <stdexcept>
 #include "Analyser.hpp"
 #include "Expression.hpp"
 #include "SemanticException.hpp"
@@ -92,7 +93,7 @@ namespace langd {
         }
 
         void Analyser::visit(parser::Negation *negation) {
-            negation->accept(this);
+            negation->expression->accept(this);
 
             if (isInt(lastExpression)) {
                 lastExpression = new Negation(lastExpression);
@@ -164,7 +165,7 @@ namespace langd {
             functionDefinition->body->accept(this);
             auto body = lastExpression;
 
-            lastExpression = new FunctionDefinition(new FunctionType(input, body->getType()),
+            lastExpression = new FunctionDefinition(TYPES.function(input, body->getType()),
                                                     symbolTable.getClosure(), asBlock(body));
             symbolTable.popScope();
         }
@@ -214,7 +215,7 @@ namespace langd {
             for (auto member: tupleType->members) {
                 members.emplace_back(member.id, mapType(member.type));
             }
-            return new TupleType(members);
+            return TYPES.tuple(members);
         }
 
         Type *Analyser::mapType(parser::Type *type) {
@@ -233,7 +234,7 @@ namespace langd {
                     throw SemanticException("Non tuple input is not yet supported");
                 }
 
-                return new FunctionType(tupleInputType, mapType(functionType->outputType));
+                return TYPES.function(tupleInputType, mapType(functionType->outputType));
             }
 
             throw logic_error("Unknown type");
@@ -6,6 +6,7 @@
 #define LANGD_CLOSURE_HPP
 
 #include <vector>
+#include "NodePool.hpp"
 
 namespace langd {
     namespace semantic {
@@ -13,6 +14,10 @@ namespace langd {
 
         class Closure {
         public:
+            Closure() {
+                NodePool::adopt(this);
+            }
+
             std::vector<Variable *> getVariables() {
                 return variables;
             }
@@ -0,0 +1,164 @@
+#include <cstdint>
+#include "ConstantFolder.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        int wrap(int64_t value) {
+            return static_cast<int>(static_cast<uint32_t>(value));
+        }
+
+        string unquote(StringConstant *constant) {
+            auto value = constant->getValue();
+            return value.substr(1, value.size() - 2);
+        }
+
+        Block *ConstantFolder::fold(Block *block) {
+            return transform(block);
+        }
+
+        bool ConstantFolder::isConstant(Expression *expression) {
+            if (dynamic_cast<IntConstant *>(expression) || dynamic_cast<StringConstant *>(expression)) {
+                return true;
+            }
+
+            if (auto tuple = dynamic_cast<Tuple *>(expression)) {
+                for (auto element: tuple->getElements()) {
+                    if (!isConstant(element.getExpression())) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            return false;
+        }
+
+        void ConstantFolder::visit(Assignment *assignment) {
+            ExpressionTransformer::visit(assignment);
+
+            auto expression = dynamic_cast<Assignment *>(lastExpression)->getExpression();
+            if (isConstant(expression)) {
+                constants[assignment->getName()] = expression;
+            } else {
+                constants.erase(assignment->getName());
+            }
+        }
+
+        void ConstantFolder::visit(VariableReference *variableReference) {
+            auto constant = constants.find(variableReference->getName());
+            if (constant != constants.end() && dynamic_cast<Tuple *>(constant->second) == nullptr) {
+                lastExpression = constant->second;
+                return;
+            }
+            lastExpression = variableReference;
+        }
+
+        void ConstantFolder::visit(PlusOperation *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto operation = dynamic_cast<PlusOperation *>(lastExpression);
+            auto lhs = dynamic_cast<IntConstant *>(operation->getLhs());
+            auto rhs = dynamic_cast<IntConstant *>(operation->getRhs());
+            if (lhs && rhs) {
+                lastExpression = new IntConstant(wrap(int64_t(lhs->getValue()) + rhs->getValue()));
+            }
+        }
+
+        void ConstantFolder::visit(MinusOperation *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto operation = dynamic_cast<MinusOperation *>(lastExpression);
+            auto lhs = dynamic_cast<IntConstant *>(operation->getLhs());
+            auto rhs = dynamic_cast<IntConstant *>(operation->getRhs());
+            if (lhs && rhs) {
+                lastExpression = new IntConstant(wrap(int64_t(lhs->getValue()) - rhs->getValue()));
+            }
+        }
+
+        void ConstantFolder::visit(TimesOperation *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto operation = dynamic_cast<TimesOperation *>(lastExpression);
+            auto lhs = dynamic_cast<IntConstant *>(operation->getLhs());
+            auto rhs = dynamic_cast<IntConstant *>(operation->getRhs());
+            if (lhs && rhs) {
+                lastExpression = new IntConstant(wrap(int64_t(lhs->getValue()) * rhs->getValue()));
+            }
+        }
+
+        void ConstantFolder::visit(ShiftLeftOperation *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto operation = dynamic_cast<ShiftLeftOperation *>(lastExpression);
+            auto lhs = dynamic_cast<IntConstant *>(operation->getLhs());
+            auto rhs = dynamic_cast<IntConstant *>(operation->getRhs());
+            if (lhs && rhs) {
+                lastExpression = new IntConstant(wrap(uint32_t(lhs->getValue()) << (rhs->getValue() & 31)));
+            }
+        }
+
+        void ConstantFolder::visit(Concatenation *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto operation = dynamic_cast<Concatenation *>(lastExpression);
+            auto lhs = dynamic_cast<StringConstant *>(operation->getLhs());
+            auto rhs = dynamic_cast<StringConstant *>(operation->getRhs());
+            if (lhs && rhs) {
+                lastExpression = new StringConstant("\"" + unquote(lhs) + unquote(rhs) + "\"");
+            }
+        }
+
+        void ConstantFolder::visit(Negation *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto negation = dynamic_cast<Negation *>(lastExpression);
+            if (auto constant = dynamic_cast<IntConstant *>(negation->getExpression())) {
+                lastExpression = new IntConstant(wrap(-int64_t(constant->getValue())));
+            }
+        }
+
+        void ConstantFolder::visit(MemberSelection *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto selection = dynamic_cast<MemberSelection *>(lastExpression);
+            auto tuple = dynamic_cast<Tuple *>(resolveTuple(selection->getExpression()));
+            if (tuple == nullptr) {
+                return;
+            }
+
+            auto index = tuple->getType()->indexOf(selection->getElement().getName());
+            if (index < 0) {
+                return;
+            }
+            lastExpression = tuple->getElements()[index].getExpression();
+        }
+
+        Expression *ConstantFolder::resolveTuple(Expression *expression) {
+            if (auto reference = dynamic_cast<VariableReference *>(expression)) {
+                auto constant = constants.find(reference->getName());
+                if (constant != constants.end()) {
+                    return constant->second;
+                }
+                return nullptr;
+            }
+
+            if (isConstant(expression)) {
+                return expression;
+            }
+            return nullptr;
+        }
+
+        void ConstantFolder::visit(FunctionDefinition *expression) {
+            auto outerConstants = constants;
+            for (auto member: expression->getType()->getInputType()->getMembers()) {
+                constants.erase(member.getName());
+            }
+
+            ExpressionTransformer::visit(expression);
+
+            constants = outerConstants;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef LANGD_CONSTANTFOLDER_HPP
+#define LANGD_CONSTANTFOLDER_HPP
+
+#include <map>
+#include <string>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class ConstantFolder : public ExpressionTransformer {
+        public:
+            Block *fold(Block *block);
+
+            void visit(Assignment *assignment) override;
+
+            void visit(VariableReference *variableReference) override;
+
+            void visit(PlusOperation *expression) override;
+
+            void visit(MinusOperation *expression) override;
+
+            void visit(TimesOperation *expression) override;
+
+            void visit(ShiftLeftOperation *expression) override;
+
+            void visit(Concatenation *expression) override;
+
+            void visit(Negation *expression) override;
+
+            void visit(MemberSelection *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+            static bool isConstant(Expression *expression);
+
+        private:
+            std::map<std::string, Expression *> constants;
+
+            Expression *resolveTuple(Expression *expression);
+        };
+    }
+}
+
+#endif //LANGD_CONSTANTFOLDER_HPP
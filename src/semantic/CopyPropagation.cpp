@@ -0,0 +1,91 @@
+#include <set>
+#include "CopyPropagation.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        Block *CopyPropagation::propagate(Block *block) {
+            return transform(block);
+        }
+
+        vector<Expression *> CopyPropagation::transformStatements(vector<Expression *> statements) {
+            vector<Expression *> result;
+            for (auto statement: statements) {
+                auto transformed = transform(statement);
+                result.push_back(transformed);
+
+                auto assignment = dynamic_cast<Assignment *>(transformed);
+                if (assignment == nullptr) {
+                    continue;
+                }
+
+                if (auto reference = dynamic_cast<VariableReference *>(assignment->getExpression())) {
+                    copies[assignment->getName()] = reference->getName();
+                    types[reference->getName()] = reference->getType();
+                }
+            }
+            return result;
+        }
+
+        string CopyPropagation::resolve(string name) {
+            auto copy = copies.find(name);
+            if (copy == copies.end()) {
+                return name;
+            }
+
+            propagated++;
+            return copy->second;
+        }
+
+        void CopyPropagation::visit(VariableReference *variableReference) {
+            auto name = resolve(variableReference->getName());
+            if (name == variableReference->getName()) {
+                lastExpression = variableReference;
+                return;
+            }
+            lastExpression = new VariableReference(name, variableReference->getType());
+        }
+
+        void CopyPropagation::visit(FunctionCall *expression) {
+            auto input = transform(expression->getInput());
+            auto name = resolve(expression->getFunction());
+            if (input == expression->getInput() && name == expression->getFunction()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new FunctionCall(name, input, expression->getType());
+        }
+
+        void CopyPropagation::visit(FunctionDefinition *expression) {
+            set<string> rebound;
+            for (auto member: expression->getType()->getInputType()->getMembers()) {
+                rebound.insert(member.getName());
+            }
+            for (auto statement: expression->getBody()->getExpressions()) {
+                if (auto assignment = dynamic_cast<Assignment *>(statement)) {
+                    rebound.insert(assignment->getName());
+                }
+            }
+
+            auto outerCopies = copies;
+            for (auto copy: outerCopies) {
+                if (rebound.count(copy.first) != 0 || rebound.count(copy.second) != 0) {
+                    copies.erase(copy.first);
+                }
+            }
+
+            ExpressionTransformer::visit(expression);
+
+            copies = outerCopies;
+        }
+
+        Variable *CopyPropagation::resolveCapture(string name) {
+            auto type = types.find(name);
+            if (type == types.end()) {
+                return nullptr;
+            }
+            return new Variable(name, type->second);
+        }
+    }
+}
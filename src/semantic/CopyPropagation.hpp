@@ -0,0 +1,40 @@
+#ifndef LANGD_COPYPROPAGATION_HPP
+#define LANGD_COPYPROPAGATION_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class CopyPropagation : public ExpressionTransformer {
+        public:
+            Block *propagate(Block *block);
+
+            void visit(VariableReference *variableReference) override;
+
+            void visit(FunctionCall *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+            int getPropagated() {
+                return propagated;
+            }
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+            Variable *resolveCapture(std::string name) override;
+
+        private:
+            std::map<std::string, std::string> copies;
+            std::map<std::string, Type *> types;
+            int propagated = 0;
+
+            std::string resolve(std::string name);
+        };
+    }
+}
+
+#endif //LANGD_COPYPROPAGATION_HPP
@@ -0,0 +1,118 @@
+#include <map>
+#include <set>
+#include "DeadCodeElimination.hpp"
+#include "FreeVariables.hpp"
+#include "TupleUses.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        class Retyper : public ExpressionTransformer {
+        public:
+            explicit Retyper(map<string, Type *> types) : types(types) {}
+
+            void visit(VariableReference *variableReference) override {
+                auto type = types.find(variableReference->getName());
+                if (type == types.end()) {
+                    lastExpression = variableReference;
+                    return;
+                }
+                lastExpression = new VariableReference(variableReference->getName(), type->second);
+            }
+
+        private:
+            map<string, Type *> types;
+        };
+
+        Block *DeadCodeElimination::eliminate(Block *block) {
+            return transform(block);
+        }
+
+        vector<Expression *> DeadCodeElimination::transformStatements(vector<Expression *> statements) {
+            auto result = removeDeadStatements(ExpressionTransformer::transformStatements(statements));
+
+            auto pruned = removeUnselectedElements(result);
+            while (pruned != result) {
+                result = removeDeadStatements(pruned);
+                pruned = removeUnselectedElements(result);
+            }
+            return result;
+        }
+
+        vector<Expression *> DeadCodeElimination::removeDeadStatements(vector<Expression *> statements) {
+            set<string> live;
+            vector<Expression *> reversed;
+
+            for (int i = statements.size() - 1; i >= 0; i--) {
+                auto statement = statements[i];
+                auto assignment = dynamic_cast<Assignment *>(statement);
+                bool isLast = i == statements.size() - 1;
+
+                if (!isLast) {
+                    if (assignment == nullptr || live.count(assignment->getName()) == 0) {
+                        removedStatements++;
+                        continue;
+                    }
+                }
+
+                if (assignment != nullptr) {
+                    live.erase(assignment->getName());
+                }
+                for (auto name: FreeVariables::of(statement)) {
+                    live.insert(name);
+                }
+                reversed.push_back(statement);
+            }
+
+            return vector<Expression *>(reversed.rbegin(), reversed.rend());
+        }
+
+        vector<Expression *> DeadCodeElimination::removeUnselectedElements(vector<Expression *> statements) {
+            TupleUses uses;
+            for (auto statement: statements) {
+                uses.transform(statement);
+            }
+
+            map<string, Type *> types;
+            vector<Expression *> result;
+            for (int i = 0; i < statements.size(); i++) {
+                auto assignment = dynamic_cast<Assignment *>(statements[i]);
+                auto tuple = assignment ? dynamic_cast<Tuple *>(assignment->getExpression()) : nullptr;
+                auto name = assignment ? assignment->getName() : "";
+
+                if (tuple == nullptr || i == statements.size() - 1 || uses.escaped.count(name) != 0) {
+                    result.push_back(statements[i]);
+                    continue;
+                }
+
+                vector<TupleElement> elements;
+                for (auto element: tuple->getElements()) {
+                    if (uses.selected[name].count(element.getName()) != 0) {
+                        elements.push_back(element);
+                    }
+                }
+
+                if (elements.size() == tuple->getElements().size()) {
+                    result.push_back(statements[i]);
+                    continue;
+                }
+
+                removedElements += tuple->getElements().size() - elements.size();
+                auto prunedTuple = new Tuple(elements);
+                types[name] = prunedTuple->getType();
+                result.push_back(new Assignment(name, prunedTuple));
+            }
+
+            if (types.empty()) {
+                return statements;
+            }
+
+            Retyper retyper(types);
+            for (auto &statement: result) {
+                statement = retyper.transform(statement);
+            }
+            return result;
+        }
+    }
+}
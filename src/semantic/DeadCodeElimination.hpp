@@ -0,0 +1,35 @@
+#ifndef LANGD_DEADCODEELIMINATION_HPP
+#define LANGD_DEADCODEELIMINATION_HPP
+
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class DeadCodeElimination : public ExpressionTransformer {
+        public:
+            Block *eliminate(Block *block);
+
+            int getRemovedStatements() {
+                return removedStatements;
+            }
+
+            int getRemovedElements() {
+                return removedElements;
+            }
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+        private:
+            int removedStatements = 0;
+            int removedElements = 0;
+
+            std::vector<Expression *> removeDeadStatements(std::vector<Expression *> statements);
+
+            std::vector<Expression *> removeUnselectedElements(std::vector<Expression *> statements);
+        };
+    }
+}
+
+#endif //LANGD_DEADCODEELIMINATION_HPP
@@ -11,6 +11,7 @@
 #include "Type.hpp"
 #include "ExpressionVisitor.hpp"
 #include "SymbolTable.hpp"
+#include "NodePool.hpp"
 
 namespace langd {
     namespace semantic {
@@ -32,6 +33,8 @@ namespace langd {
 
         class TimesOperation;
 
+        class ShiftLeftOperation;
+
         class Concatenation;
 
         class Negation;
@@ -52,6 +55,14 @@ namespace langd {
 
         class Expression {
         public:
+            Expression() {
+                NodePool::adopt(this);
+            }
+
+            Expression(const Expression &) = delete;
+
+            virtual ~Expression() = default;
+
             virtual Type *getType() = 0;
 
             virtual void accept(ExpressionVisitor *visitor) = 0;
@@ -187,6 +198,21 @@ namespace langd {
             }
         };
 
+        class ShiftLeftOperation : public BinaryOperation {
+        public:
+            ShiftLeftOperation(Expression *lhs, Expression *rhs) : BinaryOperation(lhs, rhs) {
+
+            }
+
+            IntegerType *getType() override {
+                return &INTEGER;
+            }
+
+            void accept(ExpressionVisitor *visitor) override {
+                visitor->visit(this);
+            }
+        };
+
         class Concatenation : public BinaryOperation {
         public:
             Concatenation(Expression *lhs, Expression *rhs) : BinaryOperation(lhs, rhs) {
@@ -294,11 +320,14 @@ namespace langd {
             }
 
             TupleType *getType() override {
-                std::vector<TupleTypeMember> members;
-                for (TupleElement element: elements) {
-                    members.push_back(TupleTypeMember(element.getName(), element.getExpression()->getType()));
+                if (type == nullptr) {
+                    std::vector<TupleTypeMember> members;
+                    for (TupleElement element: elements) {
+                        members.push_back(TupleTypeMember(element.getName(), element.getExpression()->getType()));
+                    }
+                    type = TYPES.tuple(members);
                 }
-                return new TupleType(members);
+                return type;
             }
 
             void accept(ExpressionVisitor *visitor) override {
@@ -307,6 +336,7 @@ namespace langd {
 
         private:
             std::vector<TupleElement> elements;
+            TupleType *type = nullptr;
         };
 
         class MemberSelection : public Expression {
@@ -0,0 +1,178 @@
+#include <map>
+#include "ExpressionTransformer.hpp"
+#include "FreeVariables.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        Expression *ExpressionTransformer::transform(Expression *expression) {
+            expression->accept(this);
+            return rewrite(lastExpression);
+        }
+
+        Block *ExpressionTransformer::transform(Block *block) {
+            auto statements = transformStatements(block->getExpressions());
+            if (statements == block->getExpressions()) {
+                return block;
+            }
+            return new Block(statements);
+        }
+
+        vector<Expression *> ExpressionTransformer::transformStatements(vector<Expression *> statements) {
+            vector<Expression *> result;
+            for (auto statement: statements) {
+                result.push_back(transform(statement));
+            }
+            return result;
+        }
+
+        void ExpressionTransformer::visit(Block *block) {
+            lastExpression = transform(block);
+        }
+
+        void ExpressionTransformer::visit(Assignment *assignment) {
+            auto expression = transform(assignment->getExpression());
+            if (expression == assignment->getExpression()) {
+                lastExpression = assignment;
+                return;
+            }
+            lastExpression = new Assignment(assignment->getName(), expression);
+        }
+
+        void ExpressionTransformer::visit(VariableReference *variableReference) {
+            lastExpression = variableReference;
+        }
+
+        void ExpressionTransformer::visit(PlusOperation *expression) {
+            auto lhs = transform(expression->getLhs());
+            auto rhs = transform(expression->getRhs());
+            if (lhs == expression->getLhs() && rhs == expression->getRhs()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new PlusOperation(lhs, rhs);
+        }
+
+        void ExpressionTransformer::visit(MinusOperation *expression) {
+            auto lhs = transform(expression->getLhs());
+            auto rhs = transform(expression->getRhs());
+            if (lhs == expression->getLhs() && rhs == expression->getRhs()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new MinusOperation(lhs, rhs);
+        }
+
+        void ExpressionTransformer::visit(TimesOperation *expression) {
+            auto lhs = transform(expression->getLhs());
+            auto rhs = transform(expression->getRhs());
+            if (lhs == expression->getLhs() && rhs == expression->getRhs()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new TimesOperation(lhs, rhs);
+        }
+
+        void ExpressionTransformer::visit(ShiftLeftOperation *expression) {
+            auto lhs = transform(expression->getLhs());
+            auto rhs = transform(expression->getRhs());
+            if (lhs == expression->getLhs() && rhs == expression->getRhs()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new ShiftLeftOperation(lhs, rhs);
+        }
+
+        void ExpressionTransformer::visit(Concatenation *expression) {
+            auto lhs = transform(expression->getLhs());
+            auto rhs = transform(expression->getRhs());
+            if (lhs == expression->getLhs() && rhs == expression->getRhs()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new Concatenation(lhs, rhs);
+        }
+
+        void ExpressionTransformer::visit(Negation *expression) {
+            auto inner = transform(expression->getExpression());
+            if (inner == expression->getExpression()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new Negation(inner);
+        }
+
+        void ExpressionTransformer::visit(StringConstant *expression) {
+            lastExpression = expression;
+        }
+
+        void ExpressionTransformer::visit(IntConstant *expression) {
+            lastExpression = expression;
+        }
+
+        void ExpressionTransformer::visit(Tuple *expression) {
+            vector<TupleElement> elements;
+            bool changed = false;
+            for (auto element: expression->getElements()) {
+                auto inner = transform(element.getExpression());
+                changed = changed || inner != element.getExpression();
+                elements.emplace_back(element.getName(), inner);
+            }
+
+            if (!changed) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new Tuple(elements);
+        }
+
+        void ExpressionTransformer::visit(MemberSelection *expression) {
+            auto inner = transform(expression->getExpression());
+            if (inner == expression->getExpression()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new MemberSelection(inner, expression->getElement());
+        }
+
+        void ExpressionTransformer::visit(FunctionCall *expression) {
+            auto input = transform(expression->getInput());
+            if (input == expression->getInput()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new FunctionCall(expression->getFunction(), input, expression->getType());
+        }
+
+        void ExpressionTransformer::visit(FunctionDefinition *expression) {
+            auto body = transform(expression->getBody());
+            if (body == expression->getBody()) {
+                lastExpression = expression;
+                return;
+            }
+
+            lastExpression = new FunctionDefinition(expression->getType(), rebuildClosure(expression, body), body);
+        }
+
+        Closure *ExpressionTransformer::rebuildClosure(FunctionDefinition *original, Block *body) {
+            map<string, Variable *> variables;
+            for (auto variable: original->getClosure()->getVariables()) {
+                variables[variable->getName()] = variable;
+            }
+
+            auto candidate = new FunctionDefinition(original->getType(), original->getClosure(), body);
+
+            auto closure = new Closure();
+            for (auto name: FreeVariables::of(candidate)) {
+                auto variable = variables.find(name);
+                if (variable != variables.end()) {
+                    closure->addVariable(variable->second);
+                } else if (auto captured = resolveCapture(name)) {
+                    closure->addVariable(captured);
+                }
+            }
+            return closure;
+        }
+    }
+}
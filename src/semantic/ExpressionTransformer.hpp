@@ -0,0 +1,64 @@
+#ifndef LANGD_EXPRESSIONTRANSFORMER_HPP
+#define LANGD_EXPRESSIONTRANSFORMER_HPP
+
+#include <vector>
+#include "Expression.hpp"
+#include "Closure.hpp"
+
+namespace langd {
+    namespace semantic {
+        class ExpressionTransformer : public ExpressionVisitor {
+        public:
+            virtual Expression *transform(Expression *expression);
+
+            Block *transform(Block *block);
+
+            void visit(Block *block) override;
+
+            void visit(Assignment *assignment) override;
+
+            void visit(VariableReference *variableReference) override;
+
+            void visit(PlusOperation *expression) override;
+
+            void visit(MinusOperation *expression) override;
+
+            void visit(TimesOperation *expression) override;
+
+            void visit(ShiftLeftOperation *expression) override;
+
+            void visit(Concatenation *expression) override;
+
+            void visit(Negation *expression) override;
+
+            void visit(StringConstant *expression) override;
+
+            void visit(IntConstant *expression) override;
+
+            void visit(Tuple *expression) override;
+
+            void visit(MemberSelection *expression) override;
+
+            void visit(FunctionCall *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+        protected:
+            Expression *lastExpression;
+
+            virtual Expression *rewrite(Expression *expression) {
+                return expression;
+            }
+
+            virtual std::vector<Expression *> transformStatements(std::vector<Expression *> statements);
+
+            Closure *rebuildClosure(FunctionDefinition *original, Block *body);
+
+            virtual Variable *resolveCapture(std::string name) {
+                return nullptr;
+            }
+        };
+    }
+}
+
+#endif //LANGD_EXPRESSIONTRANSFORMER_HPP
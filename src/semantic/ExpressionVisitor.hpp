@@ -19,6 +19,8 @@ namespace langd {
 
         class TimesOperation;
 
+        class ShiftLeftOperation;
+
         class Concatenation;
 
         class Negation;
@@ -51,6 +53,8 @@ namespace langd {
 
             virtual void visit(TimesOperation *expression) = 0;
 
+            virtual void visit(ShiftLeftOperation *expression) = 0;
+
             virtual void visit(Concatenation *expression) = 0;
 
             virtual void visit(Negation *expression) = 0;
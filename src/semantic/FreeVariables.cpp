@@ -0,0 +1,168 @@
+#include <algorithm>
+#include "FreeVariables.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        vector<string> FreeVariables::of(Expression *expression) {
+            FreeVariables freeVariables;
+            expression->accept(&freeVariables);
+            return freeVariables.names;
+        }
+
+        vector<string> FreeVariables::of(vector<Expression *> statements) {
+            FreeVariables freeVariables;
+            freeVariables.visitStatements(statements);
+            return freeVariables.names;
+        }
+
+        void FreeVariables::visit(Block *block) {
+            visitStatements(block->getExpressions());
+        }
+
+        void FreeVariables::visitStatements(vector<Expression *> statements) {
+            scopes.emplace_back();
+            for (auto statement: statements) {
+                statement->accept(this);
+            }
+            scopes.pop_back();
+        }
+
+        void FreeVariables::visit(Assignment *assignment) {
+            assignment->getExpression()->accept(this);
+            if (!scopes.empty()) {
+                scopes.back().insert(assignment->getName());
+            }
+        }
+
+        void FreeVariables::visit(VariableReference *variableReference) {
+            reference(variableReference->getName());
+        }
+
+        void FreeVariables::visit(PlusOperation *expression) {
+            expression->getLhs()->accept(this);
+            expression->getRhs()->accept(this);
+        }
+
+        void FreeVariables::visit(MinusOperation *expression) {
+            expression->getLhs()->accept(this);
+            expression->getRhs()->accept(this);
+        }
+
+        void FreeVariables::visit(TimesOperation *expression) {
+            expression->getLhs()->accept(this);
+            expression->getRhs()->accept(this);
+        }
+
+        void FreeVariables::visit(ShiftLeftOperation *expression) {
+            expression->getLhs()->accept(this);
+            expression->getRhs()->accept(this);
+        }
+
+        void FreeVariables::visit(Concatenation *expression) {
+            expression->getLhs()->accept(this);
+            expression->getRhs()->accept(this);
+        }
+
+        void FreeVariables::visit(Negation *expression) {
+            expression->getExpression()->accept(this);
+        }
+
+        void FreeVariables::visit(StringConstant *expression) {
+        }
+
+        void FreeVariables::visit(IntConstant *expression) {
+        }
+
+        void FreeVariables::visit(Tuple *expression) {
+            for (auto element: expression->getElements()) {
+                element.getExpression()->accept(this);
+            }
+        }
+
+        void FreeVariables::visit(MemberSelection *expression) {
+            expression->getExpression()->accept(this);
+        }
+
+        void FreeVariables::visit(FunctionCall *expression) {
+            reference(expression->getFunction());
+            expression->getInput()->accept(this);
+        }
+
+        void FreeVariables::visit(FunctionDefinition *expression) {
+            set<string> parameters;
+            for (auto member: expression->getType()->getInputType()->getMembers()) {
+                parameters.insert(member.getName());
+            }
+
+            scopes.push_back(parameters);
+            expression->getBody()->accept(this);
+            scopes.pop_back();
+        }
+
+        void FreeVariables::reference(string name) {
+            for (auto &scope: scopes) {
+                if (scope.count(name) != 0) {
+                    return;
+                }
+            }
+
+            if (seen.insert(name).second) {
+                names.push_back(name);
+            }
+        }
+    
+        vector<string> FreeVariableIndex::of(int first, vector<string> candidates) {
+            index();
+
+            vector<pair<pair<int, int>, string>> found;
+            for (auto name: candidates) {
+                auto nameUses = uses.find(name);
+                if (nameUses == uses.end()) {
+                    continue;
+                }
+
+                auto use = lower_bound(nameUses->second.begin(), nameUses->second.end(), make_pair(first, 0));
+                if (use == nameUses->second.end()) {
+                    continue;
+                }
+
+                auto nameDefinitions = definitions.find(name);
+                if (nameDefinitions != definitions.end()) {
+                    auto definition = lower_bound(nameDefinitions->second.begin(), nameDefinitions->second.end(), first);
+                    if (definition != nameDefinitions->second.end() && *definition < use->first) {
+                        continue;
+                    }
+                }
+
+                found.push_back(make_pair(*use, name));
+            }
+
+            sort(found.begin(), found.end());
+            vector<string> names;
+            for (auto entry: found) {
+                names.push_back(entry.second);
+            }
+            return names;
+        }
+
+        void FreeVariableIndex::index() {
+            if (indexed) {
+                return;
+            }
+            indexed = true;
+
+            for (int i = 0; i < statements.size(); i++) {
+                auto names = FreeVariables::of(statements[i]);
+                for (int j = 0; j < names.size(); j++) {
+                    uses[names[j]].push_back(make_pair(i, j));
+                }
+
+                if (auto assignment = dynamic_cast<Assignment *>(statements[i])) {
+                    definitions[assignment->getName()].push_back(i);
+                }
+            }
+        }
+    }
+}
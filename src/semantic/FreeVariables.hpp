@@ -0,0 +1,76 @@
+#ifndef LANGD_FREEVARIABLES_HPP
+#define LANGD_FREEVARIABLES_HPP
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Expression.hpp"
+
+namespace langd {
+    namespace semantic {
+        class FreeVariables : public ExpressionVisitor {
+        public:
+            static std::vector<std::string> of(Expression *expression);
+
+            static std::vector<std::string> of(std::vector<Expression *> statements);
+
+            void visit(Block *block) override;
+
+            void visit(Assignment *assignment) override;
+
+            void visit(VariableReference *variableReference) override;
+
+            void visit(PlusOperation *expression) override;
+
+            void visit(MinusOperation *expression) override;
+
+            void visit(TimesOperation *expression) override;
+
+            void visit(ShiftLeftOperation *expression) override;
+
+            void visit(Concatenation *expression) override;
+
+            void visit(Negation *expression) override;
+
+            void visit(StringConstant *expression) override;
+
+            void visit(IntConstant *expression) override;
+
+            void visit(Tuple *expression) override;
+
+            void visit(MemberSelection *expression) override;
+
+            void visit(FunctionCall *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+        private:
+            std::vector<std::string> names;
+            std::set<std::string> seen;
+            std::vector<std::set<std::string>> scopes;
+
+            void visitStatements(std::vector<Expression *> statements);
+
+            void reference(std::string name);
+        };
+
+        class FreeVariableIndex {
+        public:
+            explicit FreeVariableIndex(std::vector<Expression *> statements) : statements(statements) {}
+
+            std::vector<std::string> of(int first, std::vector<std::string> candidates);
+
+        private:
+            std::vector<Expression *> statements;
+            bool indexed = false;
+            std::map<std::string, std::vector<std::pair<int, int>>> uses;
+            std::map<std::string, std::vector<int>> definitions;
+
+            void index();
+        };
+    }
+}
+
+#endif //LANGD_FREEVARIABLES_HPP
@@ -0,0 +1,152 @@
+#include "Inliner.hpp"
+#include "NodeCount.hpp"
+#include "Renamer.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        class UseCount : public ExpressionTransformer {
+        public:
+            map<string, int> uses;
+
+            void visit(VariableReference *variableReference) override {
+                uses[variableReference->getName()]++;
+                ExpressionTransformer::visit(variableReference);
+            }
+
+            void visit(FunctionCall *expression) override {
+                uses[expression->getFunction()]++;
+                ExpressionTransformer::visit(expression);
+            }
+        };
+
+        Block *Inliner::inlineCalls(Block *block) {
+            return transform(block);
+        }
+
+        vector<Expression *> Inliner::transformStatements(vector<Expression *> statements) {
+            auto outerState = state;
+            state = State();
+
+            UseCount useCount;
+            for (auto statement: statements) {
+                useCount.transform(statement);
+            }
+            state.uses = useCount.uses;
+
+            vector<Expression *> result;
+            for (auto statement: statements) {
+                auto transformed = transform(statement);
+                result.insert(result.end(), state.pending.begin(), state.pending.end());
+                state.pending.clear();
+                result.push_back(transformed);
+
+                auto assignment = dynamic_cast<Assignment *>(transformed);
+                if (assignment == nullptr) {
+                    continue;
+                }
+                if (auto definition = dynamic_cast<FunctionDefinition *>(assignment->getExpression())) {
+                    state.definitions[assignment->getName()] = definition;
+                }
+                if (auto alias = dynamic_cast<VariableReference *>(assignment->getExpression())) {
+                    auto definition = state.definitions.find(alias->getName());
+                    if (definition != state.definitions.end()) {
+                        state.definitions[assignment->getName()] = definition->second;
+                    }
+                }
+            }
+
+            state = outerState;
+            return result;
+        }
+
+        void Inliner::visit(FunctionCall *expression) {
+            auto input = transform(expression->getInput());
+
+            auto definition = state.definitions.find(expression->getFunction());
+            if (definition != state.definitions.end() && shouldInline(expression, definition->second)) {
+                lastExpression = inlineCall(expression, input, definition->second);
+                return;
+            }
+
+            if (input == expression->getInput()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new FunctionCall(expression->getFunction(), input, expression->getType());
+        }
+
+        bool Inliner::shouldInline(FunctionCall *call, FunctionDefinition *definition) {
+            auto size = NodeCount::of(definition->getBody());
+            auto uses = state.uses[call->getFunction()];
+
+            if (size <= MAX_INLINE_SIZE || uses == 1) {
+                decisions.push_back("inlined " + call->getFunction() + " (size " + to_string(size)
+                                    + ", " + to_string(uses) + " uses)");
+                return true;
+            }
+
+            decisions.push_back("kept call to " + call->getFunction() + " (size " + to_string(size)
+                                + ", " + to_string(uses) + " uses)");
+            return false;
+        }
+
+        Expression *Inliner::inlineCall(FunctionCall *call, Expression *input, FunctionDefinition *definition) {
+            Renamer renamer;
+            vector<Expression *> statements;
+
+            auto members = definition->getType()->getInputType()->getMembers();
+            auto tuple = dynamic_cast<Tuple *>(input);
+            string inputName;
+            if (tuple == nullptr) {
+                inputName = freshName("input");
+                statements.push_back(new Assignment(inputName, input));
+            }
+
+            for (int i = 0; i < members.size(); i++) {
+                auto name = freshName(members[i].getName());
+                renamer.rename(members[i].getName(), name, members[i].getType());
+
+                Expression *value;
+                if (tuple != nullptr) {
+                    value = tuple->getElements()[i].getExpression();
+                } else {
+                    auto inputType = dynamic_cast<TupleType *>(input->getType());
+                    value = new MemberSelection(new VariableReference(inputName, inputType),
+                                                inputType->getMembers()[i]);
+                }
+                statements.push_back(new Assignment(name, value));
+            }
+
+            for (auto statement: definition->getBody()->getExpressions()) {
+                if (auto assignment = dynamic_cast<Assignment *>(statement)) {
+                    renamer.rename(assignment->getName(), freshName(assignment->getName()), assignment->getType());
+                }
+            }
+            for (auto statement: definition->getBody()->getExpressions()) {
+                statements.push_back(renamer.transform(statement));
+            }
+
+            for (int i = 0; i < statements.size() - 1; i++) {
+                auto statement = transform(statements[i]);
+                state.pending.push_back(statement);
+
+                auto assignment = dynamic_cast<Assignment *>(statement);
+                if (assignment == nullptr) {
+                    continue;
+                }
+                if (auto nested = dynamic_cast<FunctionDefinition *>(assignment->getExpression())) {
+                    state.definitions[assignment->getName()] = nested;
+                }
+            }
+
+            auto result = transform(statements.back());
+            if (auto assignment = dynamic_cast<Assignment *>(result)) {
+                state.pending.push_back(assignment);
+                return new VariableReference(assignment->getName(), assignment->getType());
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef LANGD_INLINER_HPP
+#define LANGD_INLINER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class Inliner : public ExpressionTransformer {
+        public:
+            Block *inlineCalls(Block *block);
+
+            void visit(FunctionCall *expression) override;
+
+            std::vector<std::string> getDecisions() {
+                return decisions;
+            }
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+        private:
+            static const int MAX_INLINE_SIZE = 16;
+
+            struct State {
+                std::map<std::string, FunctionDefinition *> definitions;
+                std::map<std::string, int> uses;
+                std::vector<Expression *> pending;
+            };
+
+            State state;
+            int nextName = 0;
+            std::vector<std::string> decisions;
+
+            bool shouldInline(FunctionCall *call, FunctionDefinition *definition);
+
+            Expression *inlineCall(FunctionCall *call, Expression *input, FunctionDefinition *definition);
+
+            std::string freshName(std::string name) {
+                return name + "$" + std::to_string(nextName++);
+            }
+        };
+    }
+}
+
+#endif //LANGD_INLINER_HPP
@@ -0,0 +1,29 @@
+#ifndef LANGD_NODECOUNT_HPP
+#define LANGD_NODECOUNT_HPP
+
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class NodeCount : public ExpressionTransformer {
+        public:
+            using ExpressionTransformer::transform;
+
+            static int of(Expression *expression) {
+                NodeCount nodeCount;
+                nodeCount.transform(expression);
+                return nodeCount.count;
+            }
+
+            Expression *transform(Expression *expression) override {
+                count++;
+                return ExpressionTransformer::transform(expression);
+            }
+
+        private:
+            int count = 0;
+        };
+    }
+}
+
+#endif //LANGD_NODECOUNT_HPP
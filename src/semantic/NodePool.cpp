@@ -0,0 +1,46 @@
+#include "NodePool.hpp"
+#include "Expression.hpp"
+#include "Closure.hpp"
+#include "SymbolTable.hpp"
+
+namespace langd {
+    namespace semantic {
+        thread_local NodePool *NodePool::current = nullptr;
+
+        NodePool::NodePool() : previous(current) {
+            current = this;
+        }
+
+        NodePool::~NodePool() {
+            current = previous;
+
+            for (auto expression: expressions) {
+                delete expression;
+            }
+            for (auto closure: closures) {
+                delete closure;
+            }
+            for (auto variable: variables) {
+                delete variable;
+            }
+        }
+
+        void NodePool::adopt(Expression *expression) {
+            if (current != nullptr) {
+                current->expressions.push_back(expression);
+            }
+        }
+
+        void NodePool::adopt(Closure *closure) {
+            if (current != nullptr) {
+                current->closures.push_back(closure);
+            }
+        }
+
+        void NodePool::adopt(Variable *variable) {
+            if (current != nullptr) {
+                current->variables.push_back(variable);
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef LANGD_NODEPOOL_HPP
+#define LANGD_NODEPOOL_HPP
+
+#include <vector>
+
+namespace langd {
+    namespace semantic {
+        class Expression;
+
+        class Closure;
+
+        class Variable;
+
+        class NodePool {
+        public:
+            NodePool();
+
+            NodePool(const NodePool &) = delete;
+
+            NodePool &operator=(const NodePool &) = delete;
+
+            ~NodePool();
+
+            static void adopt(Expression *expression);
+
+            static void adopt(Closure *closure);
+
+            static void adopt(Variable *variable);
+
+        private:
+            static thread_local NodePool *current;
+
+            NodePool *previous;
+            std::vector<Expression *> expressions;
+            std::vector<Closure *> closures;
+            std::vector<Variable *> variables;
+        };
+    }
+}
+
+#endif //LANGD_NODEPOOL_HPP
@@ -0,0 +1,132 @@
+#include <chrono>
+#include <memory>
+#include "PassManager.hpp"
+#include "Inliner.hpp"
+#include "Specializer.hpp"
+#include "ConstantFolder.hpp"
+#include "Simplifier.hpp"
+#include "ValueNumbering.hpp"
+#include "ScalarReplacement.hpp"
+#include "CopyPropagation.hpp"
+#include "DeadCodeElimination.hpp"
+#include "NodeCount.hpp"
+#include "Verifier.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        PassManager::PassManager(int optimizationLevel) {
+            if (optimizationLevel >= 2) {
+                iterations = MAX_ITERATIONS;
+
+                auto inliner = make_shared<Inliner>();
+                addPass(Pass("inliner", [inliner](Block *block, vector<string> &statistics) {
+                    auto decisions = inliner->getDecisions().size();
+                    block = inliner->inlineCalls(block);
+                    auto allDecisions = inliner->getDecisions();
+                    statistics.assign(allDecisions.begin() + decisions, allDecisions.end());
+                    return block;
+                }));
+
+                auto specializer = make_shared<Specializer>();
+                addPass(Pass("specializer", [specializer](Block *block, vector<string> &statistics) {
+                    int clones = specializer->getClones();
+                    block = specializer->specialize(block);
+                    statistics.push_back("cloned " + to_string(specializer->getClones() - clones));
+                    return block;
+                }));
+            }
+
+            if (optimizationLevel >= 1) {
+                addPass(Pass("constant folding", [](Block *block, vector<string> &) {
+                    return ConstantFolder().fold(block);
+                }));
+
+                addPass(Pass("simplifier", [](Block *block, vector<string> &statistics) {
+                    Simplifier simplifier;
+                    block = simplifier.simplify(block);
+                    for (auto hit: simplifier.getHits()) {
+                        statistics.push_back(hit.first + ": " + to_string(hit.second));
+                    }
+                    return block;
+                }));
+
+                auto valueNumbering = make_shared<ValueNumbering>();
+                addPass(Pass("value numbering", [valueNumbering](Block *block, vector<string> &statistics) {
+                    int eliminated = valueNumbering->getEliminated();
+                    block = valueNumbering->eliminate(block);
+                    statistics.push_back("eliminated " + to_string(valueNumbering->getEliminated() - eliminated));
+                    return block;
+                }));
+
+                addPass(Pass("scalar replacement", [](Block *block, vector<string> &statistics) {
+                    ScalarReplacement scalarReplacement;
+                    block = scalarReplacement.replace(block);
+                    statistics.push_back("replaced " + to_string(scalarReplacement.getReplaced()) + " tuples");
+                    return block;
+                }));
+
+                addPass(Pass("copy propagation", [](Block *block, vector<string> &statistics) {
+                    CopyPropagation copyPropagation;
+                    block = copyPropagation.propagate(block);
+                    statistics.push_back("propagated " + to_string(copyPropagation.getPropagated()));
+                    return block;
+                }));
+
+                addPass(Pass("dead code elimination", [](Block *block, vector<string> &statistics) {
+                    DeadCodeElimination deadCodeElimination;
+                    block = deadCodeElimination.eliminate(block);
+                    statistics.push_back("removed " + to_string(deadCodeElimination.getRemovedStatements())
+                                         + " statements and " + to_string(deadCodeElimination.getRemovedElements())
+                                         + " tuple elements");
+                    return block;
+                }));
+            }
+        }
+
+        Block *PassManager::run(Block *block) {
+            if (verify) {
+                Verifier::verify(block, "analysis");
+            }
+
+            for (int iteration = 0; iteration < iterations; iteration++) {
+                if (statistics != nullptr) {
+                    *statistics << "iteration " << iteration << endl;
+                }
+
+                auto previousBlock = block;
+                for (auto &pass: passes) {
+                    block = runPass(pass, block);
+                }
+
+                if (block == previousBlock) {
+                    break;
+                }
+            }
+            return block;
+        }
+
+        Block *PassManager::runPass(Pass &pass, Block *block) {
+            vector<string> passStatistics;
+            int nodesBefore = statistics != nullptr ? NodeCount::of(block) : 0;
+
+            auto start = chrono::steady_clock::now();
+            auto result = pass.runOn(block, passStatistics);
+            auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+            if (verify) {
+                Verifier::verify(result, pass.getName());
+            }
+
+            if (statistics != nullptr) {
+                *statistics << pass.getName() << ": " << elapsed.count() << " us, "
+                            << nodesBefore << " -> " << NodeCount::of(result) << " nodes" << endl;
+                for (auto line: passStatistics) {
+                    *statistics << pass.getName() << ": " << line << endl;
+                }
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef LANGD_PASSMANAGER_HPP
+#define LANGD_PASSMANAGER_HPP
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Expression.hpp"
+
+namespace langd {
+    namespace semantic {
+        class Pass {
+        public:
+            Pass(std::string name, std::function<Block *(Block *, std::vector<std::string> &)> run)
+                    : name(name), run(run) {}
+
+            std::string getName() {
+                return name;
+            }
+
+            Block *runOn(Block *block, std::vector<std::string> &statistics) {
+                return run(block, statistics);
+            }
+
+        private:
+            std::string name;
+            std::function<Block *(Block *, std::vector<std::string> &)> run;
+        };
+
+        class PassManager {
+        public:
+            explicit PassManager(int optimizationLevel);
+
+            Block *run(Block *block);
+
+            void addPass(Pass pass) {
+                passes.push_back(pass);
+            }
+
+            void setVerify(bool verify) {
+                this->verify = verify;
+            }
+
+            void setStatistics(std::ostream *statistics) {
+                this->statistics = statistics;
+            }
+
+        private:
+            static const int MAX_ITERATIONS = 4;
+
+            std::vector<Pass> passes;
+            int iterations = 1;
+            bool verify = false;
+            std::ostream *statistics = nullptr;
+
+            Block *runPass(Pass &pass, Block *block);
+        };
+    }
+}
+
+#endif //LANGD_PASSMANAGER_HPP
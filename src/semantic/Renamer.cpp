@@ -0,0 +1,66 @@
+#include <set>
+#include "Renamer.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        string Renamer::resolve(string name) {
+            auto rename = renames.find(name);
+            return rename == renames.end() ? name : rename->second;
+        }
+
+        void Renamer::visit(Assignment *assignment) {
+            auto expression = transform(assignment->getExpression());
+            auto name = resolve(assignment->getName());
+            if (expression == assignment->getExpression() && name == assignment->getName()) {
+                lastExpression = assignment;
+                return;
+            }
+            lastExpression = new Assignment(name, expression);
+        }
+
+        void Renamer::visit(VariableReference *variableReference) {
+            auto name = resolve(variableReference->getName());
+            if (name == variableReference->getName()) {
+                lastExpression = variableReference;
+                return;
+            }
+            lastExpression = new VariableReference(name, variableReference->getType());
+        }
+
+        void Renamer::visit(FunctionCall *expression) {
+            auto input = transform(expression->getInput());
+            auto name = resolve(expression->getFunction());
+            if (input == expression->getInput() && name == expression->getFunction()) {
+                lastExpression = expression;
+                return;
+            }
+            lastExpression = new FunctionCall(name, input, expression->getType());
+        }
+
+        void Renamer::visit(FunctionDefinition *expression) {
+            auto outerRenames = renames;
+            for (auto member: expression->getType()->getInputType()->getMembers()) {
+                renames.erase(member.getName());
+            }
+            for (auto statement: expression->getBody()->getExpressions()) {
+                if (auto assignment = dynamic_cast<Assignment *>(statement)) {
+                    renames.erase(assignment->getName());
+                }
+            }
+
+            ExpressionTransformer::visit(expression);
+
+            renames = outerRenames;
+        }
+
+        Variable *Renamer::resolveCapture(string name) {
+            auto type = types.find(name);
+            if (type == types.end()) {
+                return nullptr;
+            }
+            return new Variable(name, type->second);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef LANGD_RENAMER_HPP
+#define LANGD_RENAMER_HPP
+
+#include <map>
+#include <string>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class Renamer : public ExpressionTransformer {
+        public:
+            void rename(std::string from, std::string to, Type *type) {
+                renames[from] = to;
+                types[to] = type;
+            }
+
+            void visit(Assignment *assignment) override;
+
+            void visit(VariableReference *variableReference) override;
+
+            void visit(FunctionCall *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+        protected:
+            Variable *resolveCapture(std::string name) override;
+
+        private:
+            std::map<std::string, std::string> renames;
+            std::map<std::string, Type *> types;
+
+            std::string resolve(std::string name);
+        };
+    }
+}
+
+#endif //LANGD_RENAMER_HPP
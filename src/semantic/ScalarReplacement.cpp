@@ -0,0 +1,83 @@
+#include <map>
+#include "ScalarReplacement.hpp"
+#include "TupleUses.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        class ElementReplacer : public ExpressionTransformer {
+        public:
+            explicit ElementReplacer(map<string, map<string, VariableReference *>> elements) : elements(elements) {}
+
+            void visit(MemberSelection *expression) override {
+                auto reference = dynamic_cast<VariableReference *>(expression->getExpression());
+                auto tuple = reference ? elements.find(reference->getName()) : elements.end();
+                if (tuple == elements.end()) {
+                    ExpressionTransformer::visit(expression);
+                    return;
+                }
+                lastExpression = tuple->second[expression->getElement().getName()];
+            }
+
+            void visit(FunctionDefinition *expression) override {
+                lastExpression = expression;
+            }
+
+        private:
+            map<string, map<string, VariableReference *>> elements;
+        };
+
+        Block *ScalarReplacement::replace(Block *block) {
+            return transform(block);
+        }
+
+        vector<Expression *> ScalarReplacement::transformStatements(vector<Expression *> statements) {
+            auto result = ExpressionTransformer::transformStatements(statements);
+
+            auto replacedTuples = replaceTuples(result);
+            while (replacedTuples != result) {
+                result = replacedTuples;
+                replacedTuples = replaceTuples(result);
+            }
+            return result;
+        }
+
+        vector<Expression *> ScalarReplacement::replaceTuples(vector<Expression *> statements) {
+            TupleUses uses;
+            for (auto statement: statements) {
+                uses.transform(statement);
+            }
+
+            map<string, map<string, VariableReference *>> elements;
+            vector<Expression *> result;
+            for (int i = 0; i < statements.size(); i++) {
+                auto assignment = dynamic_cast<Assignment *>(statements[i]);
+                auto tuple = assignment ? dynamic_cast<Tuple *>(assignment->getExpression()) : nullptr;
+
+                if (tuple == nullptr || i == statements.size() - 1 || uses.escaped.count(assignment->getName()) != 0) {
+                    result.push_back(statements[i]);
+                    continue;
+                }
+
+                replaced++;
+                for (auto element: tuple->getElements()) {
+                    auto name = assignment->getName() + "$" + element.getName();
+                    auto value = element.getExpression();
+                    elements[assignment->getName()][element.getName()] = new VariableReference(name, value->getType());
+                    result.push_back(new Assignment(name, value));
+                }
+            }
+
+            if (elements.empty()) {
+                return statements;
+            }
+
+            ElementReplacer replacer(elements);
+            for (auto &statement: result) {
+                statement = replacer.transform(statement);
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef LANGD_SCALARREPLACEMENT_HPP
+#define LANGD_SCALARREPLACEMENT_HPP
+
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class ScalarReplacement : public ExpressionTransformer {
+        public:
+            Block *replace(Block *block);
+
+            int getReplaced() {
+                return replaced;
+            }
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+        private:
+            int replaced = 0;
+
+            std::vector<Expression *> replaceTuples(std::vector<Expression *> statements);
+        };
+    }
+}
+
+#endif //LANGD_SCALARREPLACEMENT_HPP
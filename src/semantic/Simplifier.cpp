@@ -0,0 +1,165 @@
+#include "Simplifier.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        bool isInt(Expression *expression, int value) {
+            auto constant = dynamic_cast<IntConstant *>(expression);
+            return constant != nullptr && constant->getValue() == value;
+        }
+
+        bool isEmptyString(Expression *expression) {
+            auto constant = dynamic_cast<StringConstant *>(expression);
+            return constant != nullptr && constant->getValue() == "\"\"";
+        }
+
+        int powerOfTwo(Expression *expression) {
+            auto constant = dynamic_cast<IntConstant *>(expression);
+            if (constant == nullptr) {
+                return -1;
+            }
+
+            auto value = constant->getValue();
+            if (value < 2 || (value & (value - 1)) != 0) {
+                return -1;
+            }
+
+            int exponent = 0;
+            while ((1 << exponent) != value) {
+                exponent++;
+            }
+            return exponent;
+        }
+
+        template<class T>
+        Expression *withBinary(Expression *expression, function<Expression *(Expression *, Expression *)> apply) {
+            auto operation = dynamic_cast<T *>(expression);
+            if (operation == nullptr) {
+                return nullptr;
+            }
+            return apply(operation->getLhs(), operation->getRhs());
+        }
+
+        Simplifier::Simplifier() {
+            addRule(RewriteRule("add-zero", [](Expression *expression) {
+                return withBinary<PlusOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isInt(rhs, 0) ? lhs : isInt(lhs, 0) ? rhs : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("add-negation", [](Expression *expression) {
+                return withBinary<PlusOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    auto negation = dynamic_cast<Negation *>(rhs);
+                    return negation ? new MinusOperation(lhs, negation->getExpression()) : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("subtract-zero", [](Expression *expression) {
+                return withBinary<MinusOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isInt(rhs, 0) ? lhs : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("subtract-from-zero", [](Expression *expression) {
+                return withBinary<MinusOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isInt(lhs, 0) ? new Negation(rhs) : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("subtract-negation", [](Expression *expression) {
+                return withBinary<MinusOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    auto negation = dynamic_cast<Negation *>(rhs);
+                    return negation ? new PlusOperation(lhs, negation->getExpression()) : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("multiply-one", [](Expression *expression) {
+                return withBinary<TimesOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isInt(rhs, 1) ? lhs : isInt(lhs, 1) ? rhs : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("multiply-zero", [](Expression *expression) {
+                return withBinary<TimesOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isInt(rhs, 0) ? rhs : isInt(lhs, 0) ? lhs : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("multiply-minus-one", [](Expression *expression) {
+                return withBinary<TimesOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isInt(rhs, -1) ? new Negation(lhs) : isInt(lhs, -1) ? new Negation(rhs) : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("multiply-power-of-two", [](Expression *expression) {
+                return withBinary<TimesOperation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    if (powerOfTwo(rhs) > 0) {
+                        return new ShiftLeftOperation(lhs, new IntConstant(powerOfTwo(rhs)));
+                    }
+                    if (powerOfTwo(lhs) > 0) {
+                        return new ShiftLeftOperation(rhs, new IntConstant(powerOfTwo(lhs)));
+                    }
+                    return nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("double-negation", [](Expression *expression) -> Expression * {
+                auto outer = dynamic_cast<Negation *>(expression);
+                if (outer == nullptr) {
+                    return nullptr;
+                }
+
+                auto inner = dynamic_cast<Negation *>(outer->getExpression());
+                return inner ? inner->getExpression() : nullptr;
+            }));
+
+            addRule(RewriteRule("concatenate-empty", [](Expression *expression) {
+                return withBinary<Concatenation>(expression, [](Expression *lhs, Expression *rhs) -> Expression * {
+                    return isEmptyString(rhs) ? lhs : isEmptyString(lhs) ? rhs : nullptr;
+                });
+            }));
+
+            addRule(RewriteRule("select-fresh-tuple", [](Expression *expression) -> Expression * {
+                auto selection = dynamic_cast<MemberSelection *>(expression);
+                if (selection == nullptr) {
+                    return nullptr;
+                }
+
+                auto tuple = dynamic_cast<Tuple *>(selection->getExpression());
+                if (tuple == nullptr) {
+                    return nullptr;
+                }
+
+                auto index = tuple->getType()->indexOf(selection->getElement().getName());
+                return tuple->getElements()[index].getExpression();
+            }));
+        }
+
+        Block *Simplifier::simplify(Block *block) {
+            auto simplified = transform(block);
+            while (simplified != block) {
+                block = simplified;
+                simplified = transform(block);
+            }
+            return simplified;
+        }
+
+        Expression *Simplifier::rewrite(Expression *expression) {
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                for (auto &rule: rules) {
+                    auto rewritten = rule.applyTo(expression);
+                    if (rewritten != nullptr) {
+                        hits[rule.getName()]++;
+                        expression = rewritten;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+            return expression;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef LANGD_SIMPLIFIER_HPP
+#define LANGD_SIMPLIFIER_HPP
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class RewriteRule {
+        public:
+            RewriteRule(std::string name, std::function<Expression *(Expression *)> apply)
+                    : name(name), apply(apply) {}
+
+            std::string getName() {
+                return name;
+            }
+
+            Expression *applyTo(Expression *expression) {
+                return apply(expression);
+            }
+
+        private:
+            std::string name;
+            std::function<Expression *(Expression *)> apply;
+        };
+
+        class Simplifier : public ExpressionTransformer {
+        public:
+            Simplifier();
+
+            Block *simplify(Block *block);
+
+            void addRule(RewriteRule rule) {
+                rules.push_back(rule);
+            }
+
+            std::map<std::string, int> getHits() {
+                return hits;
+            }
+
+        protected:
+            Expression *rewrite(Expression *expression) override;
+
+        private:
+            std::vector<RewriteRule> rules;
+            std::map<std::string, int> hits;
+        };
+    }
+}
+
+#endif //LANGD_SIMPLIFIER_HPP
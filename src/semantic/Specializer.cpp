@@ -0,0 +1,117 @@
+#include "Specializer.hpp"
+#include "ConstantFolder.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        string constantKey(Expression *expression) {
+            if (auto constant = dynamic_cast<IntConstant *>(expression)) {
+                return to_string(constant->getValue());
+            }
+            if (auto constant = dynamic_cast<StringConstant *>(expression)) {
+                return constant->getValue();
+            }
+
+            string key = "(";
+            for (auto element: dynamic_cast<Tuple *>(expression)->getElements()) {
+                key += element.getName() + "=" + constantKey(element.getExpression()) + ",";
+            }
+            return key + ")";
+        }
+
+        Block *Specializer::specialize(Block *block) {
+            return transform(block);
+        }
+
+        vector<Expression *> Specializer::transformStatements(vector<Expression *> statements) {
+            auto outerState = state;
+            state = State();
+
+            vector<Expression *> result;
+            for (auto statement: statements) {
+                auto transformed = transform(statement);
+                result.insert(result.end(), state.pending.begin(), state.pending.end());
+                state.pending.clear();
+                result.push_back(transformed);
+
+                auto assignment = dynamic_cast<Assignment *>(transformed);
+                if (assignment == nullptr) {
+                    continue;
+                }
+                if (auto definition = dynamic_cast<FunctionDefinition *>(assignment->getExpression())) {
+                    state.definitions[assignment->getName()] = definition;
+                }
+            }
+
+            state = outerState;
+            return result;
+        }
+
+        void Specializer::visit(FunctionCall *expression) {
+            ExpressionTransformer::visit(expression);
+
+            auto call = dynamic_cast<FunctionCall *>(lastExpression);
+            auto input = dynamic_cast<Tuple *>(call->getInput());
+            auto definition = state.definitions.find(call->getFunction());
+            if (input == nullptr || definition == state.definitions.end()) {
+                return;
+            }
+
+            string key = call->getFunction() + "(";
+            bool hasConstants = false;
+            vector<TupleElement> remaining;
+            for (auto element: input->getElements()) {
+                if (ConstantFolder::isConstant(element.getExpression())) {
+                    key += constantKey(element.getExpression());
+                    hasConstants = true;
+                } else {
+                    remaining.push_back(element);
+                }
+                key += ",";
+            }
+
+            if (!hasConstants) {
+                return;
+            }
+
+            auto specialization = state.specializations.find(key);
+            string name;
+            if (specialization != state.specializations.end()) {
+                name = specialization->second;
+            } else {
+                if (clones >= MAX_CLONES) {
+                    return;
+                }
+
+                name = call->getFunction() + "$spec" + to_string(clones++);
+                state.pending.push_back(new Assignment(name, clone(definition->second, input)));
+                state.specializations[key] = name;
+            }
+
+            lastExpression = new FunctionCall(name, new Tuple(remaining), call->getType());
+        }
+
+        FunctionDefinition *Specializer::clone(FunctionDefinition *definition, Tuple *input) {
+            auto members = definition->getType()->getInputType()->getMembers();
+
+            vector<TupleTypeMember> parameters;
+            vector<Expression *> statements;
+            for (int i = 0; i < members.size(); i++) {
+                auto value = input->getElements()[i].getExpression();
+                if (ConstantFolder::isConstant(value)) {
+                    statements.push_back(new Assignment(members[i].getName(), value));
+                } else {
+                    parameters.push_back(members[i]);
+                }
+            }
+
+            for (auto statement: definition->getBody()->getExpressions()) {
+                statements.push_back(statement);
+            }
+
+            auto type = TYPES.function(TYPES.tuple(parameters), definition->getType()->getOutputType());
+            return new FunctionDefinition(type, definition->getClosure(), new Block(statements));
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef LANGD_SPECIALIZER_HPP
+#define LANGD_SPECIALIZER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class Specializer : public ExpressionTransformer {
+        public:
+            Block *specialize(Block *block);
+
+            void visit(FunctionCall *expression) override;
+
+            int getClones() {
+                return clones;
+            }
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+        private:
+            static const int MAX_CLONES = 64;
+
+            struct State {
+                std::map<std::string, FunctionDefinition *> definitions;
+                std::map<std::string, std::string> specializations;
+                std::vector<Expression *> pending;
+            };
+
+            State state;
+            int clones = 0;
+
+            FunctionDefinition *clone(FunctionDefinition *definition, Tuple *input);
+        };
+    }
+}
+
+#endif //LANGD_SPECIALIZER_HPP
@@ -3,6 +3,7 @@
 //
 
 #include "SymbolTable.hpp"
+#include <stdexcept>
 #include "SemanticException.hpp"
 
 using namespace std;
@@ -102,6 +103,13 @@ namespace langd {
             registerType("Void", &VOID);
         }
 
+        SymbolTable::~SymbolTable() {
+            while (innerScope->getParent() != innerScope) {
+                popScope();
+            }
+            delete innerScope;
+        }
+
         Variable *SymbolTable::getVariable(string name) {
             return innerScope->getVariable(name);
         }
@@ -127,7 +135,9 @@ namespace langd {
         }
 
         void SymbolTable::popScope() {
+            auto scope = innerScope;
             innerScope = innerScope->getParent();
+            delete scope;
         }
     }
 }
\ No newline at end of file
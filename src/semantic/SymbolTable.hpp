@@ -9,6 +9,7 @@
 #include <map>
 #include "Expression.hpp"
 #include "Closure.hpp"
+#include "NodePool.hpp"
 
 namespace langd {
     namespace semantic {
@@ -20,7 +21,9 @@ namespace langd {
 
         class Variable {
         public:
-            Variable(std::string name, Type* type): name(name), type(type) {}
+            Variable(std::string name, Type* type): name(name), type(type) {
+                NodePool::adopt(this);
+            }
 
             std::string getName() {
                 return name;
@@ -37,6 +40,8 @@ namespace langd {
 
         class Scope {
         public:
+            virtual ~Scope() = default;
+
             virtual Variable* getVariable(std::string name) = 0;
             virtual void registerVariable(Variable *variable) = 0;
 
@@ -51,6 +56,10 @@ namespace langd {
         public:
             SymbolTable();
 
+            SymbolTable(const SymbolTable &) = delete;
+
+            ~SymbolTable();
+
             Variable* getVariable(std::string name);
             void registerVariable(Variable *variable);
 
@@ -0,0 +1,46 @@
+#ifndef LANGD_TUPLEUSES_HPP
+#define LANGD_TUPLEUSES_HPP
+
+#include <map>
+#include <set>
+#include <string>
+#include "ExpressionTransformer.hpp"
+#include "FreeVariables.hpp"
+
+namespace langd {
+    namespace semantic {
+        class TupleUses : public ExpressionTransformer {
+        public:
+            std::map<std::string, std::set<std::string>> selected;
+            std::set<std::string> escaped;
+
+            void visit(VariableReference *variableReference) override {
+                escaped.insert(variableReference->getName());
+                ExpressionTransformer::visit(variableReference);
+            }
+
+            void visit(MemberSelection *expression) override {
+                if (auto reference = dynamic_cast<VariableReference *>(expression->getExpression())) {
+                    selected[reference->getName()].insert(expression->getElement().getName());
+                    lastExpression = expression;
+                    return;
+                }
+                ExpressionTransformer::visit(expression);
+            }
+
+            void visit(FunctionCall *expression) override {
+                escaped.insert(expression->getFunction());
+                ExpressionTransformer::visit(expression);
+            }
+
+            void visit(FunctionDefinition *expression) override {
+                for (auto name: FreeVariables::of(expression)) {
+                    escaped.insert(name);
+                }
+                lastExpression = expression;
+            }
+        };
+    }
+}
+
+#endif //LANGD_TUPLEUSES_HPP
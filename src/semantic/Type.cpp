@@ -10,6 +10,7 @@ namespace langd {
         StringType STRING;
         VoidType VOID;
         IntegerType INTEGER;
+        TypeTable TYPES;
 
         bool VoidType::isAssignableFrom(Type *other) {
             return true;
@@ -42,6 +43,15 @@ namespace langd {
             return true;
         }
 
+        int TupleType::indexOf(std::string name) {
+            for (int i = 0; i < members.size(); i++) {
+                if (members[i].getName() == name) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
         bool TupleTypeMember::isAssignableFrom(TupleTypeMember other) {
             if(name != "" && other.name != "") {
                 if(name != other.name) {
@@ -62,6 +72,48 @@ namespace langd {
                     otherFunc->outputType->isAssignableFrom(outputType);
         }
 
+        TypeTable::~TypeTable() {
+            for (auto tuple: tuples) {
+                delete tuple.second;
+            }
+            for (auto function: functions) {
+                delete function.second;
+            }
+        }
+
+        TupleType *TypeTable::tuple(std::vector<TupleTypeMember> members) {
+            std::vector<std::pair<std::string, Type *>> key;
+            for (auto member: members) {
+                key.emplace_back(member.getName(), member.getType());
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto existing = tuples.find(key);
+            if (existing != tuples.end()) {
+                return existing->second;
+            }
+
+            auto type = new TupleType(members);
+            tuples[key] = type;
+            return type;
+        }
+
+        FunctionType *TypeTable::function(TupleType *inputType, Type *outputType) {
+            auto key = std::make_pair(inputType, outputType);
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto existing = functions.find(key);
+            if (existing != functions.end()) {
+                return existing->second;
+            }
+
+            auto type = new FunctionType(inputType, outputType);
+            functions[key] = type;
+            return type;
+        }
+
 
     }
 }
\ No newline at end of file
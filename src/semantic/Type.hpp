@@ -5,7 +5,10 @@
 #ifndef LANGD_TYPE_HPP
 #define LANGD_TYPE_HPP
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include "TypeVisitor.hpp"
 
@@ -72,6 +75,8 @@ namespace langd {
                 return members;
             }
 
+            int indexOf(std::string name);
+
             bool isAssignableFrom(Type *other) override;
 
             void accept(TypeVisitor *visitor) override {
@@ -126,9 +131,28 @@ namespace langd {
             Type *outputType;
         };
 
+        class TypeTable {
+        public:
+            TypeTable() = default;
+
+            TypeTable(const TypeTable &) = delete;
+
+            ~TypeTable();
+
+            TupleType *tuple(std::vector<TupleTypeMember> members);
+
+            FunctionType *function(TupleType *inputType, Type *outputType);
+
+        private:
+            std::map<std::vector<std::pair<std::string, Type *>>, TupleType *> tuples;
+            std::map<std::pair<TupleType *, Type *>, FunctionType *> functions;
+            std::mutex mutex;
+        };
+
         extern StringType STRING;
         extern VoidType VOID;
         extern IntegerType INTEGER;
+        extern TypeTable TYPES;
     }
 }
 
@@ -23,6 +23,8 @@ namespace langd {
 
         class TypeVisitor {
         public:
+            virtual ~TypeVisitor() = default;
+
             virtual void visit(VoidType *type) = 0;
 
             virtual void visit(StringType *type) = 0;
@@ -0,0 +1,200 @@
+#include <cstdint>
+#include "ValueNumbering.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        class ValueTable : public ExpressionVisitor {
+        public:
+            map<Expression *, int> numbers;
+            map<Expression *, vector<Expression *>> children;
+
+            int number(Expression *expression) {
+                auto known = numbers.find(expression);
+                if (known != numbers.end()) {
+                    return known->second;
+                }
+
+                key = "";
+                expression->accept(this);
+
+                auto value = values.find(key);
+                int valueNumber;
+                if (value == values.end()) {
+                    valueNumber = values.size();
+                    values[key] = valueNumber;
+                } else {
+                    valueNumber = value->second;
+                }
+
+                numbers[expression] = valueNumber;
+                return valueNumber;
+            }
+
+            void visit(Block *expression) override {
+                opaque(expression);
+            }
+
+            void visit(Assignment *expression) override {
+                opaque(expression);
+            }
+
+            void visit(VariableReference *expression) override {
+                key = "v:" + expression->getName();
+            }
+
+            void visit(PlusOperation *expression) override {
+                binary("+", expression, expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(MinusOperation *expression) override {
+                binary("-", expression, expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(TimesOperation *expression) override {
+                binary("*", expression, expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(ShiftLeftOperation *expression) override {
+                binary("<<", expression, expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(Concatenation *expression) override {
+                binary("++", expression, expression->getLhs(), expression->getRhs());
+            }
+
+            void visit(Negation *expression) override {
+                auto inner = number(expression->getExpression());
+                children[expression] = {expression->getExpression()};
+                key = "neg(" + to_string(inner) + ")";
+            }
+
+            void visit(StringConstant *expression) override {
+                key = "s:" + expression->getValue();
+            }
+
+            void visit(IntConstant *expression) override {
+                key = "i:" + to_string(expression->getValue());
+            }
+
+            void visit(Tuple *expression) override {
+                string tupleKey = "tuple(";
+                for (auto element: expression->getElements()) {
+                    tupleKey += element.getName() + "=" + to_string(number(element.getExpression())) + ",";
+                    children[expression].push_back(element.getExpression());
+                }
+                key = tupleKey + ")";
+            }
+
+            void visit(MemberSelection *expression) override {
+                auto inner = number(expression->getExpression());
+                children[expression] = {expression->getExpression()};
+                key = "select(" + to_string(inner) + "," + expression->getElement().getName() + ")";
+            }
+
+            void visit(FunctionCall *expression) override {
+                auto input = number(expression->getInput());
+                children[expression] = {expression->getInput()};
+                key = "call(" + expression->getFunction() + "," + to_string(input) + ")";
+            }
+
+            void visit(FunctionDefinition *expression) override {
+                opaque(expression);
+            }
+
+        private:
+            map<string, int> values;
+            string key;
+
+            void binary(string operation, Expression *expression, Expression *lhs, Expression *rhs) {
+                auto lhsNumber = number(lhs);
+                auto rhsNumber = number(rhs);
+                children[expression] = {lhs, rhs};
+                key = operation + "(" + to_string(lhsNumber) + "," + to_string(rhsNumber) + ")";
+            }
+
+            void opaque(Expression *expression) {
+                key = "opaque:" + to_string(reinterpret_cast<uintptr_t>(expression));
+            }
+        };
+
+        bool isWorthReusing(Expression *expression) {
+            return dynamic_cast<BinaryOperation *>(expression) != nullptr
+                   || dynamic_cast<Negation *>(expression) != nullptr
+                   || dynamic_cast<Tuple *>(expression) != nullptr
+                   || dynamic_cast<MemberSelection *>(expression) != nullptr
+                   || dynamic_cast<FunctionCall *>(expression) != nullptr;
+        }
+
+        Block *ValueNumbering::eliminate(Block *block) {
+            return transform(block);
+        }
+
+        vector<Expression *> ValueNumbering::transformStatements(vector<Expression *> statements) {
+            auto outerState = state;
+            state = State();
+
+            ValueTable table;
+            for (auto statement: statements) {
+                auto root = statement;
+                if (auto assignment = dynamic_cast<Assignment *>(statement)) {
+                    root = assignment->getExpression();
+                }
+                table.number(root);
+                count(root, table);
+            }
+            state.numbers = table.numbers;
+
+            vector<Expression *> result;
+            for (auto statement: statements) {
+                auto transformed = ExpressionTransformer::transform(statement);
+                result.insert(result.end(), state.pending.begin(), state.pending.end());
+                state.pending.clear();
+                result.push_back(transformed);
+            }
+
+            state = outerState;
+            return result;
+        }
+
+        void ValueNumbering::count(Expression *expression, ValueTable &table) {
+            if (state.occurrences[table.numbers[expression]]++ > 0) {
+                return;
+            }
+
+            for (auto child: table.children[expression]) {
+                count(child, table);
+            }
+        }
+
+        Expression *ValueNumbering::transform(Expression *expression) {
+            auto number = state.numbers.find(expression);
+            if (number == state.numbers.end() || !isWorthReusing(expression)
+                || state.occurrences[number->second] < 2) {
+                return ExpressionTransformer::transform(expression);
+            }
+
+            auto binding = state.bindings.find(number->second);
+            if (binding != state.bindings.end()) {
+                eliminated++;
+                return new VariableReference(binding->second, expression->getType());
+            }
+
+            auto value = ExpressionTransformer::transform(expression);
+            auto name = "cse$" + to_string(nextName++);
+            state.pending.push_back(new Assignment(name, value));
+            state.bindings[number->second] = name;
+            return new VariableReference(name, expression->getType());
+        }
+
+        void ValueNumbering::visit(FunctionDefinition *expression) {
+            auto outerState = state;
+            state = State();
+
+            ExpressionTransformer::visit(expression);
+
+            state = outerState;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef LANGD_VALUENUMBERING_HPP
+#define LANGD_VALUENUMBERING_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class ValueTable;
+
+        class ValueNumbering : public ExpressionTransformer {
+        public:
+            using ExpressionTransformer::transform;
+
+            Block *eliminate(Block *block);
+
+            Expression *transform(Expression *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+            int getEliminated() {
+                return eliminated;
+            }
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+        private:
+            struct State {
+                std::map<Expression *, int> numbers;
+                std::map<int, int> occurrences;
+                std::map<int, std::string> bindings;
+                std::vector<Expression *> pending;
+            };
+
+            State state;
+            int nextName = 0;
+            int eliminated = 0;
+
+            void count(Expression *expression, ValueTable &table);
+        };
+    }
+}
+
+#endif //LANGD_VALUENUMBERING_HPP
@@ -0,0 +1,90 @@
+#include <stdexcept>
+#include "Verifier.hpp"
+#include "FreeVariables.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace semantic {
+        void Verifier::verify(Block *block, string stage) {
+            Verifier verifier;
+            verifier.stage = stage;
+            verifier.transform(block);
+        }
+
+        vector<Expression *> Verifier::transformStatements(vector<Expression *> statements) {
+            if (statements.empty()) {
+                fail("empty block");
+            }
+
+            scopes.emplace_back();
+            for (auto statement: statements) {
+                transform(statement);
+                if (auto assignment = dynamic_cast<Assignment *>(statement)) {
+                    if (!scopes.back().insert(assignment->getName()).second) {
+                        fail(assignment->getName() + " is defined twice in the same scope");
+                    }
+                }
+            }
+            scopes.pop_back();
+            return statements;
+        }
+
+        void Verifier::visit(VariableReference *variableReference) {
+            check(variableReference->getName());
+            lastExpression = variableReference;
+        }
+
+        void Verifier::visit(FunctionCall *expression) {
+            check(expression->getFunction());
+            transform(expression->getInput());
+            lastExpression = expression;
+        }
+
+        void Verifier::visit(FunctionDefinition *expression) {
+            set<string> captured;
+            for (auto variable: expression->getClosure()->getVariables()) {
+                check(variable->getName());
+                captured.insert(variable->getName());
+            }
+
+            for (auto name: FreeVariables::of(expression)) {
+                if (captured.count(name) == 0) {
+                    fail("function uses " + name + " without capturing it");
+                }
+            }
+
+            set<string> parameters;
+            for (auto member: expression->getType()->getInputType()->getMembers()) {
+                parameters.insert(member.getName());
+            }
+            parameters.insert(captured.begin(), captured.end());
+
+            auto outerScopes = scopes;
+            scopes = {parameters};
+            transform(expression->getBody());
+            scopes = outerScopes;
+
+            lastExpression = expression;
+        }
+
+        bool Verifier::isDefined(string name) {
+            for (auto &scope: scopes) {
+                if (scope.count(name) != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Verifier::check(string name) {
+            if (!isDefined(name)) {
+                fail(name + " is used before it is defined");
+            }
+        }
+
+        void Verifier::fail(string message) {
+            throw logic_error("IR verification failed after " + stage + ": " + message);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef LANGD_VERIFIER_HPP
+#define LANGD_VERIFIER_HPP
+
+#include <set>
+#include <string>
+#include <vector>
+#include "ExpressionTransformer.hpp"
+
+namespace langd {
+    namespace semantic {
+        class Verifier : public ExpressionTransformer {
+        public:
+            static void verify(Block *block, std::string stage);
+
+            void visit(VariableReference *variableReference) override;
+
+            void visit(FunctionCall *expression) override;
+
+            void visit(FunctionDefinition *expression) override;
+
+        protected:
+            std::vector<Expression *> transformStatements(std::vector<Expression *> statements) override;
+
+        private:
+            std::string stage;
+            std::vector<std::set<std::string>> scopes;
+
+            bool isDefined(std::string name);
+
+            void check(std::string name);
+
+            void fail(std::string message);
+        };
+    }
+}
+
+#endif //LANGD_VERIFIER_HPP
@@ -0,0 +1,106 @@
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static bool writeAll(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        auto count = ::write(fd, data, size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += count;
+        size -= count;
+    }
+    return true;
+}
+
+static string readAll(int fd) {
+    string result;
+    char buffer[65536];
+    ssize_t count;
+    while ((count = ::read(fd, buffer, sizeof(buffer))) != 0) {
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        result.append(buffer, count);
+    }
+    return result;
+}
+
+static string absolutePath(string path) {
+    if (path.empty() || path[0] == '/') {
+        return path;
+    }
+
+    char directory[PATH_MAX];
+    if (getcwd(directory, sizeof(directory)) == nullptr) {
+        return path;
+    }
+    return string(directory) + "/" + path;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " socket [langd options]" << endl;
+        return 2;
+    }
+
+    string request;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        request += arg + "\n";
+        if ((arg == "-o" || arg == "-d") && i + 1 < argc) {
+            request += absolutePath(argv[++i]) + "\n";
+        }
+    }
+    request += "\n" + readAll(STDIN_FILENO);
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, argv[1], sizeof(address.sun_path) - 1);
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0 || connect(server, (sockaddr *) &address, sizeof(address)) != 0) {
+        cerr << "Could not connect to " << argv[1] << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    if (!writeAll(server, request.data(), request.size())) {
+        cerr << "Could not send request: " << strerror(errno) << endl;
+        return 1;
+    }
+    shutdown(server, SHUT_WR);
+
+    auto response = readAll(server);
+    close(server);
+
+    auto headerEnd = response.find('\n');
+    if (headerEnd == string::npos) {
+        cerr << "Invalid response from " << argv[1] << endl;
+        return 1;
+    }
+
+    int status = atoi(response.c_str());
+    size_t errorsSize = strtoul(response.c_str() + response.find(' ') + 1, nullptr, 10);
+    auto errors = response.substr(headerEnd + 1, errorsSize);
+    auto output = response.substr(min(response.size(), headerEnd + 1 + errorsSize));
+
+    cerr << errors;
+    writeAll(STDOUT_FILENO, output.data(), output.size());
+    return status;
+}
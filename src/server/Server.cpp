@@ -0,0 +1,133 @@
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <semantic/SemanticException.hpp>
+#include "Server.hpp"
+
+using namespace std;
+
+namespace langd {
+    namespace server {
+        static bool writeAll(int fd, const char *data, size_t size) {
+            while (size > 0) {
+                auto count = ::write(fd, data, size);
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += count;
+                size -= count;
+            }
+            return true;
+        }
+
+        void Server::run() {
+            signal(SIGPIPE, SIG_IGN);
+
+            sockaddr_un address;
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (socketPath.size() >= sizeof(address.sun_path)) {
+                throw runtime_error("Socket path is too long: " + socketPath);
+            }
+            strcpy(address.sun_path, socketPath.c_str());
+
+            int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listener < 0) {
+                throw runtime_error(string("Could not create socket: ") + strerror(errno));
+            }
+
+            unlink(socketPath.c_str());
+            if (bind(listener, (sockaddr *) &address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+                close(listener);
+                throw runtime_error("Could not listen on " + socketPath + ": " + strerror(errno));
+            }
+
+            while (true) {
+                int client = accept(listener, nullptr, nullptr);
+                if (client < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    close(listener);
+                    throw runtime_error(string("Could not accept connection: ") + strerror(errno));
+                }
+
+                thread(&Server::serve, this, client).detach();
+            }
+        }
+
+        void Server::serve(int client) {
+            string request;
+            char buffer[65536];
+            ssize_t count;
+            while ((count = ::read(client, buffer, sizeof(buffer))) != 0) {
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    close(client);
+                    return;
+                }
+                request.append(buffer, count);
+            }
+
+            vector<string> arguments;
+            size_t position = 0;
+            while (position < request.size()) {
+                auto end = request.find('\n', position);
+                if (end == string::npos) {
+                    end = request.size();
+                }
+
+                auto line = request.substr(position, end - position);
+                position = end + 1;
+                if (line.empty()) {
+                    break;
+                }
+                arguments.push_back(line);
+            }
+            auto source = position < request.size() ? request.substr(position) : "";
+
+            FILE *output = tmpfile();
+            if (output == nullptr) {
+                close(client);
+                return;
+            }
+
+            ostringstream errors;
+            int status;
+            try {
+                codegen::Output out(fileno(output));
+                status = compile(arguments, source, out, errors);
+                out.flush();
+            } catch (semantic::SemanticException &exception) {
+                errors << exception.getMessage() << '\n';
+                status = 1;
+            } catch (exception &exception) {
+                errors << exception.what() << '\n';
+                status = 1;
+            }
+
+            auto header = to_string(status) + " " + to_string(errors.str().size()) + "\n" + errors.str();
+            bool written = writeAll(client, header.data(), header.size());
+
+            rewind(output);
+            while (written && (count = fread(buffer, 1, sizeof(buffer), output)) > 0) {
+                written = writeAll(client, buffer, count);
+            }
+
+            fclose(output);
+            close(client);
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef LANGD_SERVER_HPP
+#define LANGD_SERVER_HPP
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <codegen/Output.hpp>
+
+namespace langd {
+    namespace server {
+        typedef std::function<int(std::vector<std::string> arguments, std::string source,
+                                  codegen::Output &out, std::ostream &errors)> CompileHandler;
+
+        class Server {
+        public:
+            Server(std::string socketPath, CompileHandler compile) : socketPath(socketPath), compile(compile) {}
+
+            void run();
+
+        private:
+            std::string socketPath;
+            CompileHandler compile;
+
+            void serve(int client);
+        };
+    }
+}
+
+#endif //LANGD_SERVER_HPP